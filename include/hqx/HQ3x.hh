@@ -40,6 +40,18 @@ class HQ3x : public HQx
 			uint32_t trA = 0x50,
 			bool wrapX = false,
 			bool wrapY = false ) const;
+
+		uint32_t getFactor() const;
+
+		void interpolate(
+			int pattern,
+			const uint32_t *w,
+			uint32_t *output,
+			int lineSize,
+			uint32_t trY,
+			uint32_t trU,
+			uint32_t trV,
+			uint32_t trA ) const;
 };
 
 
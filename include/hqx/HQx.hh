@@ -19,6 +19,7 @@
 
 
 #include <stdint.h>
+#include <cstddef>
 
 
 #define MASK_RB   0x00FF00FF
@@ -136,6 +137,132 @@
 #define MIX_22_5_7_1_1		*(output + lineSize + lineSize + 2) = HQX_MIX_2(w[5],w[7],1U,1U);
 
 
+class ThreadPool;
+class HQxFilter;
+struct HQxStatsData;
+struct HQxGrayRules;
+
+
+/**
+ * @brief Geometric transforms applied to the output while it is written.
+ *
+ * Rotations are clockwise. With HQX_ROTATE_90 and HQX_ROTATE_270 the width
+ * and height of the output are swapped.
+ */
+enum HQxTransform
+{
+	HQX_IDENTITY,
+	HQX_ROTATE_90,
+	HQX_ROTATE_180,
+	HQX_ROTATE_270,
+	HQX_FLIP_H,
+	HQX_FLIP_V
+};
+
+
+/**
+ * @brief Format of the pixels given to and produced by the scalers.
+ */
+enum HQxColorSpace
+{
+	/// Packed ARGB, converted to YUV only for the color comparisons
+	HQX_ARGB,
+	/// Packed AYUV (alpha, Y, U and V from the most significant byte), compared
+	/// and interpolated as is
+	HQX_AYUV
+};
+
+
+/**
+ * @brief How the alpha channel of ARGB pixels is handled.
+ */
+enum HQxAlphaMode
+{
+	/// Alpha is interpolated like any other channel
+	HQX_ALPHA_STRAIGHT,
+	/// Straight alpha, but the blocks of pixels whose whole neighborhood is
+	/// transparent are written as zeros without being interpolated
+	HQX_ALPHA_SKIP,
+	/// Premultiplied alpha in the input and in the output; the blocks of pixels
+	/// whose whole neighborhood is zero are written as zeros
+	HQX_ALPHA_PREMULTIPLIED
+};
+
+
+/**
+ * @brief Trade-off between the speed and the quality of the scalers.
+ */
+enum HQxQuality
+{
+	/// Every comparison uses the thresholds
+	HQX_QUALITY_FULL,
+	/// The comparisons between the sides of the window made by the composite
+	/// cases only check whether the colors are equal
+	HQX_QUALITY_FAST
+};
+
+
+/**
+ * @brief Planar YUV image with 8 bits per sample.
+ */
+struct HQxYUVImage
+{
+	/// Y, U, V and alpha planes (the alpha plane is optional)
+	uint8_t *planes[4];
+	/// Number of bytes between the beginning of consecutive rows of each plane
+	uint32_t strides[4];
+	/// Whether the U and V planes have half the width and height (4:2:0)
+	bool subsampled;
+};
+
+
+/**
+ * @brief Source and output of one image of a batch.
+ */
+struct HQxSprite
+{
+	/// First pixel of the source
+	const uint32_t *image;
+	uint32_t width;
+	uint32_t height;
+	/// Number of pixels between the beginning of consecutive source rows
+	uint32_t stride;
+	/// Top-left corner of the output (after the transform of the scaler)
+	uint32_t *output;
+	/// Number of pixels between the beginning of consecutive output rows
+	uint32_t outputStride;
+};
+
+
+/**
+ * @brief Rectangle of a sprite in an atlas, in source pixels.
+ */
+struct HQxRect
+{
+	uint32_t x;
+	uint32_t y;
+	uint32_t width;
+	uint32_t height;
+};
+
+
+/**
+ * @brief Per-pattern counters collected when the library is built with
+ * HQX_STATS defined (CMake option HQX_ENABLE_STATS).
+ */
+struct HQxStats
+{
+	/// Number of source pixels processed with each pattern
+	uint64_t hits[256];
+	/// Number of extra color comparisons made by the interpolation of each pattern
+	uint64_t checks[256];
+	/// Sum of the sampled interpolation cost, in CPU cycles
+	uint64_t cycles[256];
+	/// Number of samples in @c cycles
+	uint64_t samples[256];
+};
+
+
 class HQx
 {
 	public:
@@ -158,6 +285,258 @@ class HQx
 			bool wrapX = false,
 			bool wrapY = false ) const = 0;
 
+		/**
+		 * @brief Resizes only the source rows in the range [firstRow, lastRow).
+		 *
+		 * The pointers @c image and @c output always refer to the beginning of
+		 * the whole images, so different row ranges can be processed at the
+		 * same time by different threads.
+		 */
+		uint32_t *resizeRows(
+			const uint32_t *image,
+			uint32_t width,
+			uint32_t height,
+			uint32_t *output,
+			uint32_t firstRow,
+			uint32_t lastRow,
+			uint32_t trY = 0x30,
+			uint32_t trU = 0x07,
+			uint32_t trV = 0x06,
+			uint32_t trA = 0x50,
+			bool wrapX = false,
+			bool wrapY = false ) const;
+
+		/**
+		 * @brief Resizes the rows in the range [firstRow, lastRow) with the
+		 * given quality instead of the one set with @c setQuality.
+		 *
+		 * The scaler is not changed, so threads sharing it can resize their
+		 * rows with different qualities.
+		 */
+		uint32_t *resizeRows(
+			const uint32_t *image,
+			uint32_t width,
+			uint32_t height,
+			uint32_t *output,
+			uint32_t firstRow,
+			uint32_t lastRow,
+			uint32_t trY,
+			uint32_t trU,
+			uint32_t trV,
+			uint32_t trA,
+			bool wrapX,
+			bool wrapY,
+			HQxQuality quality ) const;
+
+		/**
+		 * @brief Resizes the image splitting the rows in bands which are
+		 * processed by the threads of the given pool.
+		 */
+		uint32_t *resizeParallel(
+			ThreadPool &pool,
+			const uint32_t *image,
+			uint32_t width,
+			uint32_t height,
+			uint32_t *output,
+			uint32_t trY = 0x30,
+			uint32_t trU = 0x07,
+			uint32_t trV = 0x06,
+			uint32_t trA = 0x50,
+			bool wrapX = false,
+			bool wrapY = false ) const;
+
+		/**
+		 * @brief Resizes an image stored in the same buffer as the output.
+		 *
+		 * The buffer has room for the output and the image is stored at its
+		 * end, starting at the offset width * height * (factor * factor - 1),
+		 * so no separate source buffer is needed. The rows are processed from
+		 * the top, whose output never reaches the source rows still needed by
+		 * the next windows. Only the output of the last row, which overlaps
+		 * the last source rows, is produced in a small temporary buffer. The
+		 * result is the same produced by @c resize. The transform and the
+		 * filter are not used.
+		 */
+		uint32_t *resizeInPlace(
+			uint32_t *buffer,
+			uint32_t width,
+			uint32_t height,
+			uint32_t trY = 0x30,
+			uint32_t trU = 0x07,
+			uint32_t trV = 0x06,
+			uint32_t trA = 0x50,
+			bool wrapX = false,
+			bool wrapY = false ) const;
+
+		/**
+		 * @brief Resizes the image with several algorithms in a single pass.
+		 *
+		 * The 3x3 window and the pattern of each source pixel are computed once
+		 * and used by the interpolation of every algorithm, which writes to
+		 * its own output (e.g. HQ2x and HQ3x versions of the same image). If
+		 * a pool is given, the rows are split in bands between its threads.
+		 */
+		static void resizeMultiple(
+			const HQx *const *scalers,
+			uint32_t count,
+			const uint32_t *image,
+			uint32_t width,
+			uint32_t height,
+			uint32_t *const *outputs,
+			uint32_t trY = 0x30,
+			uint32_t trU = 0x07,
+			uint32_t trV = 0x06,
+			uint32_t trA = 0x50,
+			bool wrapX = false,
+			bool wrapY = false,
+			ThreadPool *pool = NULL );
+
+		/**
+		 * @brief Resizes the image and resamples the result to an arbitrary size
+		 * in the same pass.
+		 *
+		 * The output of the algorithm is produced one source row at a time in a
+		 * small buffer and immediately resampled (bilinear) to @c outputWidth x
+		 * @c outputHeight, so the full-size intermediate image is never
+		 * allocated. If a pool is given, the output rows are split in bands
+		 * between its threads.
+		 */
+		uint32_t *resizeTo(
+			const uint32_t *image,
+			uint32_t width,
+			uint32_t height,
+			uint32_t *output,
+			uint32_t outputWidth,
+			uint32_t outputHeight,
+			uint32_t trY = 0x30,
+			uint32_t trU = 0x07,
+			uint32_t trV = 0x06,
+			uint32_t trA = 0x50,
+			bool wrapX = false,
+			bool wrapY = false,
+			ThreadPool *pool = NULL ) const;
+
+		/**
+		 * @brief Resizes a planar YUV image.
+		 *
+		 * The input must be 4:4:4 and the output may be 4:4:4 or 4:2:0, in
+		 * which case the chroma of each 2x2 output block is averaged while the
+		 * scaled rows are written. The comparisons and interpolations are made
+		 * in YUV, as with HQX_AYUV. Images without an alpha plane are opaque;
+		 * the output alpha plane is written only if given, and the output
+		 * chroma planes only if the U plane is given. If a pool is given,
+		 * the output rows are split in bands between its threads. The transform
+		 * and the filter of the scaler are not used.
+		 */
+		void resizeYUV(
+			const HQxYUVImage &image,
+			uint32_t width,
+			uint32_t height,
+			const HQxYUVImage &output,
+			uint32_t trY = 0x30,
+			uint32_t trU = 0x07,
+			uint32_t trV = 0x06,
+			uint32_t trA = 0x50,
+			bool wrapX = false,
+			bool wrapY = false,
+			ThreadPool *pool = NULL ) const;
+
+		/**
+		 * @brief Resizes a single-channel 8-bit image (e.g. masks, fonts or
+		 * height maps).
+		 *
+		 * The comparisons use only the difference between the values and the
+		 * threshold @c trY, and the output has 8 bits per pixel too. The pixels
+		 * are compared and blended in 8 bits, using a table with the blend of
+		 * every output pixel for each pattern (built from @c interpolate when
+		 * first needed). Scalers which do not use the patterns (see
+		 * @c usesPattern) scale the values as opaque AYUV pixels instead. If a
+		 * pool is given, the rows are split in bands between its threads. The
+		 * transform and the filter of the scaler are not used.
+		 */
+		void resizeGray(
+			const uint8_t *image,
+			uint32_t width,
+			uint32_t height,
+			uint8_t *output,
+			uint32_t trY = 0x30,
+			bool wrapX = false,
+			bool wrapY = false,
+			ThreadPool *pool = NULL ) const;
+
+		/**
+		 * @brief Resizes a batch of images in a single call.
+		 *
+		 * Each image is resized as if it were given alone to @c resize, with
+		 * its own borders, and its output is written with the given stride. If
+		 * a pool is given, the images are split in groups between its threads.
+		 * The transform is applied to each image and the filter receives the
+		 * coordinates of the pixels in the output of the image.
+		 */
+		void resizeSprites(
+			const HQxSprite *sprites,
+			uint32_t count,
+			uint32_t trY = 0x30,
+			uint32_t trU = 0x07,
+			uint32_t trV = 0x06,
+			uint32_t trA = 0x50,
+			bool wrapX = false,
+			bool wrapY = false,
+			ThreadPool *pool = NULL ) const;
+
+		/**
+		 * @brief Resizes the sprites of an atlas.
+		 *
+		 * The output is the scaled atlas, with @c width * factor pixels per row,
+		 * and each rectangle is resized into the same place of the output with
+		 * its own borders, so the neighbor sprites never bleed into each other.
+		 * The output pixels outside the rectangles are not written. The
+		 * rectangles must be square if the output is rotated by 90 or 270
+		 * degrees.
+		 */
+		void resizeAtlas(
+			const uint32_t *image,
+			uint32_t width,
+			uint32_t height,
+			uint32_t *output,
+			const HQxRect *rects,
+			uint32_t count,
+			uint32_t trY = 0x30,
+			uint32_t trU = 0x07,
+			uint32_t trV = 0x06,
+			uint32_t trA = 0x50,
+			bool wrapX = false,
+			bool wrapY = false,
+			ThreadPool *pool = NULL ) const;
+
+		/**
+		 * @brief Returns the scale factor of the algorithm.
+		 */
+		virtual uint32_t getFactor() const = 0;
+
+		/**
+		 * @brief Writes the output block of one source pixel.
+		 *
+		 * The thresholds must be already shifted to the position of their
+		 * components in the AYUV value.
+		 */
+		virtual void interpolate(
+			int pattern,
+			const uint32_t *w,
+			uint32_t *output,
+			int lineSize,
+			uint32_t trY,
+			uint32_t trU,
+			uint32_t trV,
+			uint32_t trA ) const = 0;
+
+		/**
+		 * @brief Returns whether the interpolation uses the pattern of the
+		 * window. Algorithms which only compare the colors of the window for
+		 * equality return false, so the pattern is not computed for them.
+		 */
+		virtual bool usesPattern() const;
+
 		static bool isDifferent(
 			uint32_t yuv1,
 			uint32_t yuv2,
@@ -165,6 +544,295 @@ class HQx
 			uint32_t trU,
 			uint32_t trV,
 			uint32_t trA );
+
+		/**
+		 * @brief Color comparison used for sharper images (good for cartoon
+		 * style, used by DOSBOX).
+		 */
+		static bool isDifferentSharp(
+			uint32_t yuv1,
+			uint32_t yuv2,
+			uint32_t trY,
+			uint32_t trU,
+			uint32_t trV,
+			uint32_t trA );
+
+		/**
+		 * @brief Color comparison used for smoothed images (good for complex
+		 * graphics).
+		 */
+		static bool isDifferentSmooth(
+			uint32_t yuv1,
+			uint32_t yuv2,
+			uint32_t trY,
+			uint32_t trU,
+			uint32_t trV,
+			uint32_t trA );
+
+		/**
+		 * @brief Computes the 8-bit pattern of the 3x3 window @c w, with one bit
+		 * set for every neighbor which is different from the central pixel.
+		 *
+		 * The thresholds must be already shifted (see @c interpolate).
+		 */
+		static int getPattern(
+			const uint32_t *w,
+			uint32_t trY,
+			uint32_t trU,
+			uint32_t trV,
+			uint32_t trA );
+
+		/**
+		 * @brief Computes the comparisons between the sides of the 3x3 window
+		 * @c w used by the interpolations, one bit for each pair: w1 and w5,
+		 * w5 and w7, w7 and w3, w3 and w1.
+		 *
+		 * The thresholds must be already shifted (see @c interpolate).
+		 */
+		static int getEdges(
+			const uint32_t *w,
+			uint32_t trY,
+			uint32_t trU,
+			uint32_t trV,
+			uint32_t trA );
+
+		/**
+		 * @brief Returns whether the library collects pattern statistics.
+		 */
+		static bool hasStats();
+
+		/**
+		 * @brief Copies the statistics collected since the creation of the
+		 * object or the last call to @c resetStats.
+		 *
+		 * @return False if the library was built without statistics.
+		 */
+		bool getStats(
+			HQxStats &stats ) const;
+
+		void resetStats();
+
+		/**
+		 * @brief Measures the interpolation cost of one in every @c period
+		 * pixels (zero disables the measurement).
+		 */
+		void setStatsSampling(
+			uint32_t period );
+
+		/**
+		 * @brief Sets the transform applied to the output of every resize
+		 * method (the default is HQX_IDENTITY).
+		 *
+		 * The interpolation always uses the original orientation of the image,
+		 * which is not the same as transforming the source before the scaling
+		 * because the rules of the algorithms are not symmetric.
+		 */
+		void setTransform(
+			HQxTransform transform );
+
+		HQxTransform getTransform() const;
+
+		/**
+		 * @brief Sets the filter applied to the output pixels of every resize
+		 * method before they are stored (NULL to disable).
+		 *
+		 * The output of each source row is produced in a small buffer and
+		 * filtered there, one output row at a time, so the output image is
+		 * written only once. The filter is not owned by the scaler and must
+		 * outlive its use.
+		 */
+		void setFilter(
+			const HQxFilter *filter );
+
+		const HQxFilter *getFilter() const;
+
+		/**
+		 * @brief Sets the format of the input and output pixels of every resize
+		 * method (the default is HQX_ARGB).
+		 *
+		 * With HQX_AYUV the pixels are compared without any color conversion and
+		 * the output is AYUV too. In @c resizeMultiple the color space of the
+		 * first scaler is used by all of them.
+		 */
+		void setColorSpace(
+			HQxColorSpace colorSpace );
+
+		HQxColorSpace getColorSpace() const;
+
+		/**
+		 * @brief Sets how the alpha channel is handled by every resize method
+		 * (the default is HQX_ALPHA_STRAIGHT).
+		 *
+		 * With HQX_ALPHA_SKIP and HQX_ALPHA_PREMULTIPLIED the transparent runs
+		 * of each row are found before the interpolation and their blocks are
+		 * filled with zeros, which makes sprites with large transparent areas
+		 * much cheaper. With premultiplied input the blends never mix the
+		 * hidden color of transparent pixels into the edges and the skipped
+		 * blocks are exactly what the interpolation would produce. The mode is
+		 * ignored with HQX_AYUV. In @c resizeMultiple the mode of the first
+		 * scaler is used by all of them.
+		 */
+		void setAlphaMode(
+			HQxAlphaMode alphaMode );
+
+		HQxAlphaMode getAlphaMode() const;
+
+		/**
+		 * @brief Enables the memoization of the output blocks (disabled by
+		 * default).
+		 *
+		 * In images with few colors, such as pixel art, the same 3x3 windows
+		 * appear many times. With the memoization the output blocks of recent
+		 * windows are kept in a small direct-mapped cache and copied when the
+		 * window appears again, skipping the comparisons and the blends. The
+		 * hit rate is measured in every row and the cache is not used for a
+		 * while when it is low, so images with many colors pay little for it.
+		 * The cache of each thread is kept between calls, so the bands,
+		 * sprites and tiles of one image share its blocks. Used by @c resize, @c resizeRows, @c resizeParallel, @c resizeSprites,
+		 * @c resizeAtlas and @c resizeMultiple (with the setting of the first
+		 * scaler).
+		 */
+		void setMemoization(
+			bool enabled );
+
+		bool getMemoization() const;
+
+		/**
+		 * @brief Sets the quality of every resize method (the default is
+		 * HQX_QUALITY_FULL).
+		 *
+		 * With HQX_QUALITY_FAST only the pattern is computed with the
+		 * thresholds, which skips most of the color conversions of the
+		 * composite cases. In @c resizeMultiple the quality of the first scaler
+		 * is used by all of them.
+		 */
+		void setQuality(
+			HQxQuality quality );
+
+		HQxQuality getQuality() const;
+
+		/**
+		 * @brief Converts ARGB pixels with straight alpha to premultiplied alpha.
+		 */
+		static void premultiply(
+			uint32_t *pixels,
+			size_t count );
+
+		/**
+		 * @brief Converts ARGB pixels with premultiplied alpha to straight alpha.
+		 */
+		static void unpremultiply(
+			uint32_t *pixels,
+			size_t count );
+
+	private:
+		friend class HQxMap;
+		friend class HQxProgressive;
+		friend class HQxTileCache;
+		friend class Scale2x;
+		friend class Scale3x;
+
+		HQxStatsData *statsData;
+
+		/// Blends used by resizeGray, built when first needed
+		mutable HQxGrayRules *grayRules;
+
+		HQxTransform transform;
+
+		const HQxFilter *filter;
+
+		HQxColorSpace colorSpace;
+
+		HQxAlphaMode alphaMode;
+
+		bool memoization;
+
+		HQxQuality quality;
+
+		/**
+		 * @brief Makes the comparisons of the calling thread use the given color
+		 * space and returns the previous one.
+		 */
+		static HQxColorSpace swapColorSpace(
+			HQxColorSpace colorSpace );
+
+		/**
+		 * @brief Makes the comparisons of the calling thread between the sides
+		 * of the window @c w return the given results (see @c getEdges) instead
+		 * of comparing the colors. Disabled if @c w is NULL.
+		 */
+		static void setEdges(
+			const uint32_t *w,
+			int edges );
+
+		/**
+		 * @brief Processes the source pixels in the rows [firstRow, lastRow) and
+		 * columns [firstCol, lastCol) with every scaler. Each element of
+		 * @c outputs points to the output pixel where the block of the pixel at
+		 * @c firstCol in @c firstRow starts (its top-left corner, after the
+		 * transform of the scaler if @c useTransform is set).
+		 * The transform and the filter of the scalers are used only if
+		 * @c useTransform is set. The strides are the number of pixels between
+		 * the beginning of consecutive rows of the source and of the outputs
+		 * (zero for contiguous output rows). The color space, the alpha mode
+		 * and the quality are used instead of the ones set in the scalers. If
+		 * @c memoize is set, the output blocks of repeated windows are copied
+		 * from a cache.
+		 */
+		static void processRows(
+			const HQx *const *scalers,
+			uint32_t count,
+			const uint32_t *image,
+			uint32_t width,
+			uint32_t height,
+			uint32_t stride,
+			uint32_t *const *outputs,
+			uint32_t outputStride,
+			uint32_t firstRow,
+			uint32_t lastRow,
+			uint32_t firstCol,
+			uint32_t lastCol,
+			uint32_t trY,
+			uint32_t trU,
+			uint32_t trV,
+			uint32_t trA,
+			bool wrapX,
+			bool wrapY,
+			bool useTransform,
+			HQxColorSpace colorSpace,
+			HQxAlphaMode alphaMode,
+			HQxQuality quality,
+			bool memoize );
+
+		/**
+		 * @brief Returns the blends used by @c resizeGray, building them with
+		 * @c interpolate in the first call.
+		 */
+		const HQxGrayRules &getGrayRules() const;
+
+		/**
+		 * @brief Produces the rows [firstRow, lastRow) of the output of
+		 * @c resizeTo.
+		 */
+		void resampleRows(
+			const uint32_t *image,
+			uint32_t width,
+			uint32_t height,
+			uint32_t *output,
+			uint32_t outputWidth,
+			uint32_t outputHeight,
+			uint32_t firstRow,
+			uint32_t lastRow,
+			uint32_t trY,
+			uint32_t trU,
+			uint32_t trV,
+			uint32_t trA,
+			bool wrapX,
+			bool wrapY ) const;
+
+		HQx( const HQx& );
+
+		HQx &operator=( const HQx& );
 };
 
 
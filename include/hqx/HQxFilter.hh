@@ -0,0 +1,142 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HQX_HQXFILTER_HH
+#define HQX_HQXFILTER_HH
+
+
+#include <stdint.h>
+#include <vector>
+
+
+/**
+ * @brief Post-processing applied by the scalers to the output pixels before
+ * they are stored (see @c HQx::setFilter).
+ *
+ * The coordinates are the ones of the scaled image before any transform, so
+ * the same filter works with any transform of the scaler.
+ */
+class HQxFilter
+{
+	public:
+		virtual ~HQxFilter();
+
+		/**
+		 * @brief Processes @c count consecutive pixels of the output row @c y,
+		 * starting at the column @c x.
+		 *
+		 * Called once for each output row with every pixel produced in that
+		 * row by the call (the whole row, or the part of it in a band or
+		 * tile), possibly by several threads at the same time.
+		 */
+		virtual void apply(
+			uint32_t *pixels,
+			uint32_t count,
+			uint32_t x,
+			uint32_t y ) const = 0;
+};
+
+
+/**
+ * @brief Filter calling a functor for every pixel.
+ *
+ * The functor receives the ARGB value and the coordinates of the pixel and
+ * returns the new value. It is called from a loop over the pixels of the
+ * row, so it can be inlined and vectorized by the compiler.
+ */
+template<typename F>
+class HQxFunctorFilter : public HQxFilter
+{
+	public:
+		HQxFunctorFilter(
+			const F &functor ) : functor(functor)
+		{
+		}
+
+		void apply(
+			uint32_t *pixels,
+			uint32_t count,
+			uint32_t x,
+			uint32_t y ) const
+		{
+			for (uint32_t i = 0; i < count; ++i)
+				pixels[i] = functor(pixels[i], x + i, y);
+		}
+
+	private:
+		F functor;
+};
+
+
+/**
+ * @brief Filter made of a list of common operations, applied in the order
+ * they were added.
+ */
+class HQxPostProcess : public HQxFilter
+{
+	public:
+		HQxPostProcess();
+
+		~HQxPostProcess();
+
+		/**
+		 * @brief Darkens the last @c lines rows of every group of @c period rows
+		 * (e.g. 1 of every 3 rows for HQ3x), keeping (1 - intensity) of the
+		 * original brightness.
+		 */
+		void addScanlines(
+			float intensity,
+			uint32_t period = 2,
+			uint32_t lines = 1 );
+
+		/**
+		 * @brief Multiplies the RGB components by a 3x4 matrix (row-major, the
+		 * last column is an offset in the [0, 255] range). The alpha is kept.
+		 */
+		void addColorMatrix(
+			const float *matrix );
+
+		/**
+		 * @brief Applies a gamma curve (output = input ^ gamma, in the [0, 1]
+		 * range) to the RGB components.
+		 */
+		void addGamma(
+			float gamma );
+
+		void clear();
+
+		void apply(
+			uint32_t *pixels,
+			uint32_t count,
+			uint32_t x,
+			uint32_t y ) const;
+
+	private:
+		struct Operation
+		{
+			int type;
+			uint32_t period;
+			uint32_t lines;
+			// scale factor, in 1/256 units, or matrix in 1/4096 units
+			int32_t values[12];
+			uint8_t table[256];
+		};
+
+		std::vector<Operation> operations;
+};
+
+
+#endif  // HQX_HQXFILTER_HH
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HQX_GOVERNOR_HH
+#define HQX_GOVERNOR_HH
+
+
+#include <hqx/HQx.hh>
+#include <stdint.h>
+
+
+/**
+ * @brief Summary of one frame resized by a governor.
+ */
+struct HQxFrameReport
+{
+	/// Sequential number of the frame, starting at zero
+	uint64_t frame;
+	/// Fraction of the sampled pixels equal to their right and bottom neighbors
+	double equalRatio;
+	/// Predicted time of the frame with full quality, in milliseconds
+	double predicted;
+	/// Measured time of the frame, in milliseconds
+	double elapsed;
+	/// Quality used by the scaler
+	HQxQuality quality;
+	/// Number of bands in which the rows were split
+	uint32_t bands;
+	/// Number of bands replaced by nearest-neighbor scaling
+	uint32_t nearestBands;
+	/// Whether the frame was produced with less than full quality
+	bool degraded;
+};
+
+
+/**
+ * @brief Keeps the time of the frames within a budget, degrading the quality
+ * of the frames which would exceed it.
+ *
+ * The cost of each frame is predicted from the fraction of pixels equal to
+ * their neighbors (which are cheap to scale) and from the cost measured in the
+ * previous frames. The cost of the quality not being used follows the other
+ * one with the ratio measured between them, and after many frames with the
+ * fast quality one frame uses the full quality to measure its cost again.
+ * When the prediction exceeds the budget, the rows are split in smaller bands
+ * and resized with HQX_QUALITY_FAST, without changing the quality set in the
+ * scaler. The bands which would start too late to finish within the budget
+ * are scaled with nearest-neighbor instead (only if the scaler has no
+ * transform and no filter).
+ */
+class HQxGovernor
+{
+	public:
+		/**
+		 * @brief Creates a governor for the given scaler with a budget in
+		 * milliseconds per frame. The scaler and the pool are not owned by the
+		 * governor and must outlive it.
+		 */
+		HQxGovernor(
+			HQx &scaler,
+			double budget,
+			ThreadPool *pool = NULL );
+
+		~HQxGovernor();
+
+		/**
+		 * @brief Resizes one frame and returns its report.
+		 */
+		const HQxFrameReport &resize(
+			const uint32_t *image,
+			uint32_t width,
+			uint32_t height,
+			uint32_t *output,
+			uint32_t trY = 0x30,
+			uint32_t trU = 0x07,
+			uint32_t trV = 0x06,
+			uint32_t trA = 0x50,
+			bool wrapX = false,
+			bool wrapY = false );
+
+		void setBudget(
+			double budget );
+
+		double getBudget() const;
+
+		/**
+		 * @brief Returns the report of the last frame.
+		 */
+		const HQxFrameReport &getReport() const;
+
+		uint64_t getFrames() const;
+
+		uint64_t getDegradedFrames() const;
+
+		/**
+		 * @brief Returns the fraction of the sampled pixels of the image which
+		 * are equal to their right and bottom neighbors.
+		 */
+		static double getEqualRatio(
+			const uint32_t *image,
+			uint32_t width,
+			uint32_t height );
+
+	private:
+		HQx &scaler;
+		double budget;
+		ThreadPool *pool;
+		HQxFrameReport report;
+		uint64_t frames;
+		uint64_t degradedFrames;
+		/// Consecutive frames resized with HQX_QUALITY_FAST
+		uint32_t fastFrames;
+		/// Ratio between the costs of the full and of the fast quality
+		double ratio;
+		/// Measured cost of each quality, in milliseconds per unit of work
+		double cost[2];
+};
+
+
+#endif  // HQX_GOVERNOR_HH
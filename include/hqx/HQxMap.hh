@@ -0,0 +1,120 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HQX_MAP_HH
+#define HQX_MAP_HH
+
+
+#include <hqx/HQx.hh>
+#include <stdint.h>
+#include <vector>
+
+
+/**
+ * @brief Compact map of the comparisons of an image, used to render any part
+ * of its output on demand.
+ *
+ * All the color comparisons made by the scalers are computed once, in
+ * @c build, and stored in 2 bytes per source pixel: the pattern in the lower 8
+ * bits and the comparisons between the sides of the window (see
+ * @c HQx::getEdges) in the next 4 bits. Each call to @c render produces the
+ * output of a rectangle of the image with only the blends, so huge images can
+ * be viewed without ever allocating their whole output. The same map can be
+ * rendered by every algorithm.
+ *
+ * The source image is not copied and must not change while the map is used.
+ */
+class HQxMap
+{
+	public:
+		HQxMap();
+
+		~HQxMap();
+
+		/**
+		 * @brief Computes the map of the image. If a pool is given, the rows
+		 * are split in bands between its threads.
+		 */
+		void build(
+			const uint32_t *image,
+			uint32_t width,
+			uint32_t height,
+			uint32_t trY = 0x30,
+			uint32_t trU = 0x07,
+			uint32_t trV = 0x06,
+			uint32_t trA = 0x50,
+			bool wrapX = false,
+			bool wrapY = false,
+			ThreadPool *pool = NULL );
+
+		/**
+		 * @brief Writes the output of the given rectangle of the source image.
+		 *
+		 * The output points to the top-left corner of the output of the
+		 * rectangle and @c outputStride is the number of pixels between the
+		 * beginning of consecutive output rows. The result is the same produced
+		 * by @c resize with the whole image. The transform and the filter of the
+		 * scaler are not used.
+		 */
+		void render(
+			const HQx &scaler,
+			const HQxRect &rect,
+			uint32_t *output,
+			uint32_t outputStride ) const;
+
+		/**
+		 * @brief Sets the color space used by @c build (the default is
+		 * HQX_ARGB).
+		 */
+		void setColorSpace(
+			HQxColorSpace colorSpace );
+
+		HQxColorSpace getColorSpace() const;
+
+		/**
+		 * @brief Returns the map, with one value per source pixel.
+		 */
+		const std::vector<uint16_t> &getMap() const;
+
+		uint32_t getWidth() const;
+
+		uint32_t getHeight() const;
+
+	private:
+		const uint32_t *image;
+		uint32_t width;
+		uint32_t height;
+		uint32_t trY;
+		uint32_t trU;
+		uint32_t trV;
+		uint32_t trA;
+		bool wrapX;
+		bool wrapY;
+		HQxColorSpace colorSpace;
+		std::vector<uint16_t> map;
+
+		/**
+		 * @brief Loads the 3x3 window of the given pixel, with the same borders
+		 * used by the scalers.
+		 */
+		void getWindow(
+			uint32_t x,
+			uint32_t y,
+			uint32_t *w ) const;
+};
+
+
+#endif  // HQX_MAP_HH
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HQX_PROGRESSIVE_HH
+#define HQX_PROGRESSIVE_HH
+
+
+#include <hqx/HQx.hh>
+#include <stdint.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/**
+ * @brief Progressive resizing for interactive applications.
+ *
+ * @c start writes a nearest-neighbor preview of the whole output and returns,
+ * while a background thread replaces it with the output of the scaler one tile
+ * at a time, starting with the tiles nearest to the viewport. The callback is
+ * called from the background thread after each tile is written. The final
+ * output is the same produced by @c resize.
+ *
+ * The transform and the filter of the scaler are not used. The image and the
+ * output must not be released before the refinement finishes or is cancelled.
+ */
+class HQxProgressive
+{
+	public:
+		/**
+		 * @brief Receives the rectangle of the source image whose output was
+		 * just refined.
+		 */
+		typedef std::function<void(const HQxRect &tile)> Callback;
+
+		/**
+		 * @brief Creates a renderer for the given scaler using square tiles
+		 * with @c tileSize source pixels of side. The scaler is not owned by
+		 * the renderer and must outlive it.
+		 */
+		HQxProgressive(
+			const HQx &scaler,
+			uint32_t tileSize = 64 );
+
+		/**
+		 * @brief Cancels the refinement in progress, if any.
+		 */
+		~HQxProgressive();
+
+		/**
+		 * @brief Writes the preview of the output and starts the refinement in
+		 * the background. A refinement in progress is cancelled first.
+		 */
+		void start(
+			const uint32_t *image,
+			uint32_t width,
+			uint32_t height,
+			uint32_t *output,
+			const HQxRect &viewport,
+			const Callback &callback = Callback(),
+			uint32_t trY = 0x30,
+			uint32_t trU = 0x07,
+			uint32_t trV = 0x06,
+			uint32_t trA = 0x50,
+			bool wrapX = false,
+			bool wrapY = false );
+
+		/**
+		 * @brief Changes the viewport, in source pixels, used to choose the next
+		 * tiles to refine.
+		 */
+		void setViewport(
+			const HQxRect &viewport );
+
+		/**
+		 * @brief Stops the refinement after the tile being processed and waits
+		 * for it. The tiles already refined are kept in the output.
+		 */
+		void cancel();
+
+		/**
+		 * @brief Waits for the refinement to finish.
+		 */
+		void wait();
+
+		/**
+		 * @brief Returns whether every tile was refined.
+		 */
+		bool isFinished() const;
+
+		uint32_t getTileCount() const;
+
+		uint32_t getRefinedTiles() const;
+
+	private:
+		const HQx &scaler;
+		uint32_t tileSize;
+		const uint32_t *image;
+		uint32_t width;
+		uint32_t height;
+		uint32_t *output;
+		Callback callback;
+		uint32_t trY;
+		uint32_t trU;
+		uint32_t trV;
+		uint32_t trA;
+		bool wrapX;
+		bool wrapY;
+		std::thread worker;
+		std::mutex lock;
+		HQxRect viewport;
+		/// Tiles not refined yet
+		std::vector<HQxRect> pending;
+		uint32_t tileCount;
+		std::atomic<uint32_t> refined;
+		std::atomic<bool> cancelled;
+
+		void work();
+
+		/**
+		 * @brief Removes from the pending tiles the one nearest to the viewport.
+		 */
+		bool next(
+			HQxRect &tile );
+};
+
+
+#endif  // HQX_PROGRESSIVE_HH
@@ -0,0 +1,157 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HQX_TILECACHE_HH
+#define HQX_TILECACHE_HH
+
+
+#include <hqx/HQx.hh>
+#include <stdint.h>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+
+/**
+ * @brief Counters of a tile cache.
+ */
+struct HQxTileCacheStats
+{
+	/// Number of tiles copied from the cache
+	uint64_t hits;
+	/// Number of tiles resized and stored in the cache
+	uint64_t misses;
+	/// Number of tiles removed from the cache to stay within the memory limit
+	uint64_t evictions;
+	/// Number of tiles in the cache
+	size_t entries;
+	/// Memory used by the tiles in the cache, in bytes
+	size_t memory;
+};
+
+
+/**
+ * @brief Cache of resized tiles for tile-based graphics.
+ *
+ * The output of a tile depends only on its pixels and on the ring of pixels
+ * around it, so tiles which are drawn many times with the same neighbors
+ * (e.g. the background of a game) are resized once and copied from the cache
+ * afterwards. The key is a hash of the tile and of its ring, which are also
+ * stored to rule out collisions, together with the settings of the scaler
+ * which change its output (color space, alpha mode and quality), so the tiles
+ * resized before one of them changes are not used again. The least recently
+ * used tiles are removed when the memory limit is reached.
+ *
+ * The transform and the filter of the scaler are not applied: the tiles are
+ * always written untransformed and unfiltered. The cache is not thread safe.
+ */
+class HQxTileCache
+{
+	public:
+		/**
+		 * @brief Creates a cache for the output of the given scaler using at
+		 * most @c capacity bytes. The scaler is not owned by the cache and
+		 * must outlive it.
+		 */
+		HQxTileCache(
+			const HQx &scaler,
+			size_t capacity,
+			uint32_t trY = 0x30,
+			uint32_t trU = 0x07,
+			uint32_t trV = 0x06,
+			uint32_t trA = 0x50 );
+
+		~HQxTileCache();
+
+		/**
+		 * @brief Writes the output of one tile of the image.
+		 *
+		 * The output is the whole resized image, with @c width * factor pixels
+		 * per row, and the output of the tile is written into its place. The
+		 * result is the same produced by @c resize with the whole image and
+		 * without the transform and the filter of the scaler.
+		 */
+		void draw(
+			const uint32_t *image,
+			uint32_t width,
+			uint32_t height,
+			const HQxRect &tile,
+			uint32_t *output,
+			bool wrapX = false,
+			bool wrapY = false );
+
+		/**
+		 * @brief Writes the output of the whole image, split in a grid of tiles
+		 * with the given size.
+		 */
+		void drawTiles(
+			const uint32_t *image,
+			uint32_t width,
+			uint32_t height,
+			uint32_t tileWidth,
+			uint32_t tileHeight,
+			uint32_t *output,
+			bool wrapX = false,
+			bool wrapY = false );
+
+		/**
+		 * @brief Removes every tile from the cache.
+		 */
+		void clear();
+
+		const HQxTileCacheStats &getStats() const;
+
+		/**
+		 * @brief Returns the fraction of the tiles copied from the cache.
+		 */
+		double getHitRate() const;
+
+		void resetStats();
+
+	private:
+		struct Entry
+		{
+			uint64_t hash;
+			uint32_t width;
+			uint32_t height;
+			/// Settings of the scaler used to resize the tile
+			HQxColorSpace colorSpace;
+			HQxAlphaMode alphaMode;
+			HQxQuality quality;
+			/// The tile and its ring
+			std::vector<uint32_t> source;
+			/// The output of the tile
+			std::vector<uint32_t> output;
+		};
+
+		const HQx &scaler;
+		size_t capacity;
+		uint32_t trY;
+		uint32_t trU;
+		uint32_t trV;
+		uint32_t trA;
+		HQxTileCacheStats stats;
+		/// Entries from the most to the least recently used
+		std::list<Entry> entries;
+		std::unordered_multimap<uint64_t, std::list<Entry>::iterator> index;
+		/// The tile being drawn and its ring
+		std::vector<uint32_t> source;
+
+		void evict();
+};
+
+
+#endif  // HQX_TILECACHE_HH
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HQX_SCALE2X_HH
+#define HQX_SCALE2X_HH
+
+
+#include <stdint.h>
+#include <hqx/HQx.hh>
+
+
+/**
+ * @brief Scale2x (EPX) algorithm.
+ *
+ * Much cheaper than HQ2x, it only checks whether the colors of the window are
+ * equal and copies one of them to each output pixel, without any blending. The
+ * thresholds are ignored. Without transform, filter and skipped alpha,
+ * @c resize processes the rows with SIMD instructions when available.
+ */
+class Scale2x : public HQx
+{
+	public:
+		Scale2x();
+
+		~Scale2x();
+
+		uint32_t *resize(
+			const uint32_t *image,
+			uint32_t width,
+			uint32_t height,
+			uint32_t *output,
+			uint32_t trY = 0x30,
+			uint32_t trU = 0x07,
+			uint32_t trV = 0x06,
+			uint32_t trA = 0x50,
+			bool wrapX = false,
+			bool wrapY = false ) const;
+
+		uint32_t getFactor() const;
+
+		void interpolate(
+			int pattern,
+			const uint32_t *w,
+			uint32_t *output,
+			int lineSize,
+			uint32_t trY,
+			uint32_t trU,
+			uint32_t trV,
+			uint32_t trA ) const;
+
+		bool usesPattern() const;
+};
+
+
+#endif  // HQX_SCALE2X_HH
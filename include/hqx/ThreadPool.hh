@@ -0,0 +1,77 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HQX_THREADPOOL_HH
+#define HQX_THREADPOOL_HH
+
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/**
+ * @brief Fixed set of worker threads used to run indexed tasks in parallel.
+ *
+ * The thread calling @c run also executes tasks, so a pool with size 1 has
+ * no worker threads at all and runs everything sequentially.
+ */
+class ThreadPool
+{
+	public:
+		/**
+		 * @brief Creates a pool with the given number of threads (including the
+		 * calling one). If zero, uses the number of hardware threads.
+		 */
+		ThreadPool(
+			uint32_t threads = 0 );
+
+		~ThreadPool();
+
+		uint32_t getSize() const;
+
+		/**
+		 * @brief Calls @c task for every index in [0, count) and waits all of
+		 * them to finish. Must not be called from inside a task.
+		 */
+		void run(
+			uint32_t count,
+			const std::function<void(uint32_t)> &task );
+
+	private:
+		std::vector<std::thread> workers;
+		std::mutex callLock;
+		std::mutex lock;
+		std::condition_variable wakeup;
+		std::condition_variable finished;
+		const std::function<void(uint32_t)> *task;
+		uint32_t taskCount;
+		std::atomic<uint32_t> nextTask;
+		uint32_t busy;
+		uint64_t generation;
+		bool stopping;
+
+		void work();
+
+		void execute();
+};
+
+
+#endif  // HQX_THREADPOOL_HH
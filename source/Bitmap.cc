@@ -0,0 +1,179 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Bitmap.hh"
+#include <fstream>
+#include <new>
+
+
+using std::ifstream;
+using std::ofstream;
+using std::string;
+
+
+// largest images accepted by the loader
+static const uint32_t BITMAP_MAX_SIDE = 32768;
+static const size_t BITMAP_MAX_PIXELS = 64 * 1024 * 1024;
+
+
+#pragma pack(push, 1)
+
+struct BitmapHeader
+{
+    uint16_t bfType;
+    uint32_t bfSize;
+    uint32_t bfRes1;
+    uint32_t bfOffBits;
+};
+
+struct DibHeader
+{
+	uint32_t biSize;
+	uint32_t biWidth;
+	uint32_t biHeight;
+	uint16_t biPlanes;
+	uint16_t biBitCount;
+	uint32_t biCompression;
+	uint32_t biSizeImage;
+	uint32_t biXPelsPerMeter;
+	uint32_t biYPelsPerMeter;
+	uint32_t biClrUsed;
+	uint32_t biClrImportant;
+};
+
+#pragma pack(pop)
+
+
+/**
+ * @brief Saves an Windows Bitmap image (24 BPP).
+ */
+int Bitmap::save(
+	const uint32_t *data,
+	uint32_t width,
+	uint32_t height,
+	const string &fileName )
+{
+	BitmapHeader bh;
+	DibHeader dh;
+	uint16_t suffix;
+	uint32_t zero = 0;
+	const uint32_t *ptr;
+
+	ofstream output(fileName.c_str(), std::ios_base::binary);
+	if (!output.good()) return -1;
+
+	suffix = ((width + 3) & ~0x03) - width;
+
+	dh.biSize          = sizeof(DibHeader);
+	dh.biWidth         = width;
+	dh.biHeight        = height;
+	dh.biPlanes        = 1;
+	dh.biBitCount      = 24;
+	dh.biCompression   = 0;
+	dh.biSizeImage     = (uint16_t) ( (width*3+suffix)*height );
+	dh.biXPelsPerMeter = 0x2E23;
+	dh.biYPelsPerMeter = dh.biXPelsPerMeter;
+	dh.biClrUsed       = 0;
+	dh.biClrImportant  = 0;
+
+	bh.bfType    = 0x4D42;
+	bh.bfSize    = dh.biSizeImage + 0x0036;
+	bh.bfRes1    = 0;
+	bh.bfOffBits = 0x0036;
+	output.write( (char*) &bh, sizeof(BitmapHeader) );
+	output.write( (char*) &dh, sizeof(DibHeader) );
+
+	ptr = data + (width * height);
+	for (uint32_t i = 0; i < height; i++)
+	{
+		ptr -= width;
+
+		for (uint32_t j = 0; j < width; ++j)
+			output.write( (char*) (ptr + j), 3 );
+
+		if (suffix > 0)
+			output.write( (char*) &zero, suffix );
+	}
+
+  output.close();
+
+  return 0;
+}
+
+
+/**
+ * @brief Loads an Windows Bitmap image (24 BPP).
+ */
+int Bitmap::load(
+	const string &fileName,
+	std::vector<uint32_t> &data,
+	uint32_t &width,
+	uint32_t &height )
+{
+	BitmapHeader bh;
+	DibHeader dh;
+	uint16_t  suffix;
+	uint32_t zero = 0;
+	uint32_t *ptr;
+
+	ifstream input(fileName.c_str(), std::ios_base::binary);
+	if (!input.good()) return -1;
+
+	input.read( (char*) &bh, sizeof(BitmapHeader) );
+	if (!input || bh.bfType != 0x4D42) return -1;
+	input.read( (char*) &dh.biSize, sizeof(uint32_t) );
+	if (!input || dh.biSize != 40) return -1;
+
+	input.read( (char*) &dh.biWidth, sizeof(DibHeader) - sizeof(uint32_t) );
+	if (!input || dh.biBitCount != 24 || dh.biCompression != 0) return -1;
+	// negative heights (top-down images) are not supported
+	if (dh.biWidth == 0 || dh.biHeight == 0 || (int32_t) dh.biHeight < 0) return -1;
+	if (dh.biWidth > BITMAP_MAX_SIDE || dh.biHeight > BITMAP_MAX_SIDE) return -1;
+	if ((size_t) dh.biWidth * dh.biHeight > BITMAP_MAX_PIXELS) return -1;
+	width  = dh.biWidth;
+	height = dh.biHeight;
+
+	size_t pixels = (size_t) width * height;
+	try
+	{
+		data.assign(pixels, 0);
+	}
+	catch (const std::bad_alloc &)
+	{
+		return -1;
+	}
+
+	suffix = ((width + 3) & ~0x03) - width;
+	ptr = data.data() + pixels;
+	for (uint32_t i = 0; i < height; i++)
+	{
+		ptr -= width;
+
+		for (uint32_t j = 0; j < width; ++j)
+		{
+			input.read( (char*) (ptr + j), 3 );
+			*(ptr + j) |= 0xFF000000;
+		}
+
+		if (suffix > 0)
+			input.read( (char*) &zero, suffix );
+		// truncated files are not loaded
+		if (!input) return -1;
+	}
+
+	input.close();
+	return 0;
+}
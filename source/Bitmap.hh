@@ -0,0 +1,54 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HQX_BITMAP_HH
+#define HQX_BITMAP_HH
+
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+
+/**
+ * @brief Windows Bitmap files used by the command line programs.
+ */
+class Bitmap
+{
+	public:
+		/**
+		 * @brief Saves an Windows Bitmap image (24 BPP).
+		 */
+		static int save(
+			const uint32_t *data,
+			uint32_t width,
+			uint32_t height,
+			const std::string &fileName );
+
+		/**
+		 * @brief Loads an Windows Bitmap image (24 BPP, bottom-up and
+		 * uncompressed). Returns -1 if the file is invalid, truncated or
+		 * too big.
+		 */
+		static int load(
+			const std::string &fileName,
+			std::vector<uint32_t> &data,
+			uint32_t &width,
+			uint32_t &height );
+};
+
+
+#endif  // HQX_BITMAP_HH
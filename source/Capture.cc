@@ -0,0 +1,224 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Capture.hh"
+#include <cstring>
+
+
+static const uint32_t CAPTURE_MAGIC = 0x43585148;  // "HQXC"
+static const uint32_t CAPTURE_VERSION = 1;
+static const uint32_t CAPTURE_RAW = 0;
+static const uint32_t CAPTURE_DELTA = 1;
+
+// unchanged pixels shorter than this are stored to avoid too many small runs
+static const uint32_t CAPTURE_MIN_GAP = 4;
+
+
+CaptureWriter::CaptureWriter() : output(NULL), width(0), height(0), delta(false)
+{
+	// nothing to do
+}
+
+
+CaptureWriter::~CaptureWriter()
+{
+	close();
+}
+
+
+int CaptureWriter::open(
+	const std::string &fileName,
+	uint32_t width,
+	uint32_t height,
+	bool delta )
+{
+	close();
+	if (width == 0 || height == 0) return -1;
+
+	output = fopen(fileName.c_str(), "wb");
+	if (output == NULL) return -1;
+
+	this->width = width;
+	this->height = height;
+	this->delta = delta;
+	previous.clear();
+
+	uint32_t header[4] = { CAPTURE_MAGIC, CAPTURE_VERSION, width, height };
+	if (fwrite(header, sizeof(header), 1, output) != 1) return -1;
+	return 0;
+}
+
+
+int CaptureWriter::write(
+	const uint32_t *frame )
+{
+	if (output == NULL) return -1;
+
+	size_t pixels = (size_t) width * height;
+	uint32_t type = CAPTURE_RAW;
+	const uint32_t *data = frame;
+	size_t words = pixels;
+
+	if (delta && !previous.empty())
+	{
+		payload.clear();
+		size_t i = 0, last = 0;
+		while (i < pixels)
+		{
+			if (frame[i] == previous[i])
+			{
+				++i;
+				continue;
+			}
+
+			// extends the run until a long enough sequence of unchanged pixels
+			size_t end = i + 1, gap = 0;
+			for (size_t j = i + 1; j < pixels && gap < CAPTURE_MIN_GAP; ++j)
+			{
+				if (frame[j] == previous[j])
+					++gap;
+				else
+				{
+					gap = 0;
+					end = j + 1;
+				}
+			}
+
+			payload.push_back((uint32_t) (i - last));
+			payload.push_back((uint32_t) (end - i));
+			payload.insert(payload.end(), frame + i, frame + end);
+			last = i = end;
+			if (payload.size() >= pixels) break;
+		}
+
+		if (payload.size() < pixels)
+		{
+			type = CAPTURE_DELTA;
+			data = payload.data();
+			words = payload.size();
+		}
+	}
+
+	uint32_t header[2] = { type, (uint32_t) words };
+	if (fwrite(header, sizeof(header), 1, output) != 1) return -1;
+	if (words > 0 && fwrite(data, sizeof(uint32_t), words, output) != words) return -1;
+
+	if (delta) previous.assign(frame, frame + pixels);
+	return 0;
+}
+
+
+int CaptureWriter::close()
+{
+	if (output == NULL) return 0;
+	int result = fclose(output);
+	output = NULL;
+	return (result == 0) ? 0 : -1;
+}
+
+
+CaptureReader::CaptureReader() : input(NULL), width(0), height(0)
+{
+	// nothing to do
+}
+
+
+CaptureReader::~CaptureReader()
+{
+	close();
+}
+
+
+int CaptureReader::open(
+	const std::string &fileName )
+{
+	close();
+
+	input = fopen(fileName.c_str(), "rb");
+	if (input == NULL) return -1;
+
+	uint32_t header[4];
+	if (fread(header, sizeof(header), 1, input) != 1 ||
+		header[0] != CAPTURE_MAGIC ||
+		header[1] != CAPTURE_VERSION ||
+		header[2] == 0 || header[3] == 0)
+	{
+		close();
+		return -1;
+	}
+
+	width = header[2];
+	height = header[3];
+	return 0;
+}
+
+
+uint32_t CaptureReader::getWidth() const
+{
+	return width;
+}
+
+
+uint32_t CaptureReader::getHeight() const
+{
+	return height;
+}
+
+
+int CaptureReader::read(
+	std::vector<uint32_t> &frame )
+{
+	if (input == NULL) return -1;
+
+	uint32_t header[2];
+	if (fread(header, sizeof(header), 1, input) != 1) return feof(input) ? 1 : -1;
+
+	size_t pixels = (size_t) width * height;
+	frame.resize(pixels);
+
+	if (header[0] == CAPTURE_RAW)
+	{
+		if (header[1] != pixels) return -1;
+		if (fread(frame.data(), sizeof(uint32_t), pixels, input) != pixels) return -1;
+		return 0;
+	}
+	if (header[0] != CAPTURE_DELTA) return -1;
+
+	payload.resize(header[1]);
+	if (header[1] > 0 && fread(payload.data(), sizeof(uint32_t), header[1], input) != header[1])
+		return -1;
+
+	size_t position = 0;
+	for (size_t i = 0; i + 1 < payload.size(); )
+	{
+		position += payload[i];
+		size_t count = payload[i + 1];
+		i += 2;
+		if (position + count > pixels || i + count > payload.size()) return -1;
+		memcpy(frame.data() + position, payload.data() + i, count * sizeof(uint32_t));
+		position += count;
+		i += count;
+	}
+
+	return 0;
+}
+
+
+void CaptureReader::close()
+{
+	if (input != NULL) fclose(input);
+	input = NULL;
+}
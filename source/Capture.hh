@@ -0,0 +1,119 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HQX_CAPTURE_HH
+#define HQX_CAPTURE_HH
+
+
+#include <stdint.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+/*
+ * Capture files store a sequence of ARGB frames with the same size, using the
+ * byte order of the machine:
+ *
+ *   "HQXC" | version | width | height | frame...
+ *
+ * Each frame starts with its type (raw or delta) and the number of 32-bit words
+ * of its payload. Raw frames have all the pixels, while delta frames have only
+ * the runs of pixels changed since the previous frame, as a sequence of
+ * "unchanged pixels | changed pixels | pixels" entries.
+ */
+
+
+/**
+ * @brief Records frames in a capture file.
+ */
+class CaptureWriter
+{
+	public:
+		CaptureWriter();
+
+		~CaptureWriter();
+
+		/**
+		 * @brief Creates the capture file. If @c delta is true, frames are
+		 * stored as the difference to the previous frame when that is smaller.
+		 */
+		int open(
+			const std::string &fileName,
+			uint32_t width,
+			uint32_t height,
+			bool delta );
+
+		int write(
+			const uint32_t *frame );
+
+		int close();
+
+	private:
+		FILE *output;
+		uint32_t width;
+		uint32_t height;
+		bool delta;
+		std::vector<uint32_t> previous;
+		std::vector<uint32_t> payload;
+
+		CaptureWriter( const CaptureWriter& );
+
+		CaptureWriter &operator=( const CaptureWriter& );
+};
+
+
+/**
+ * @brief Reads the frames of a capture file.
+ */
+class CaptureReader
+{
+	public:
+		CaptureReader();
+
+		~CaptureReader();
+
+		int open(
+			const std::string &fileName );
+
+		uint32_t getWidth() const;
+
+		uint32_t getHeight() const;
+
+		/**
+		 * @brief Reads the next frame. Since delta frames only have the changed
+		 * pixels, @c frame must keep the previous frame between calls.
+		 *
+		 * @return Zero if successful, 1 at the end of the file or -1 on error.
+		 */
+		int read(
+			std::vector<uint32_t> &frame );
+
+		void close();
+
+	private:
+		FILE *input;
+		uint32_t width;
+		uint32_t height;
+		std::vector<uint32_t> payload;
+
+		CaptureReader( const CaptureReader& );
+
+		CaptureReader &operator=( const CaptureReader& );
+};
+
+
+#endif  // HQX_CAPTURE_HH
@@ -0,0 +1,203 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Corpus.hh"
+#include <cstdio>
+
+
+/**
+ * @brief Deterministic pseudo-random generator (xorshift32).
+ */
+static uint32_t corpus_random(
+	uint32_t &state )
+{
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+
+static uint32_t corpus_clamp(
+	int value )
+{
+	return (value < 0) ? 0 : ((value > 255) ? 255 : (uint32_t) value);
+}
+
+
+void Corpus::generate(
+	const CorpusSpec &spec,
+	uint32_t width,
+	uint32_t height,
+	std::vector<uint32_t> &image )
+{
+	uint32_t state = spec.seed ? spec.seed : 1;
+	std::vector<uint32_t> palette;
+
+	for (uint32_t i = 0; i < spec.colors; ++i)
+		palette.push_back(0xFF000000 | (corpus_random(state) & 0x00FFFFFF));
+
+	// the image is made of square cells: the less edges, the bigger the cells
+	uint32_t cellSize = 1 + (100 - spec.edgeDensity) * 15 / 100;
+	uint32_t cellsX = (width + cellSize - 1) / cellSize;
+	uint32_t cellsY = (height + cellSize - 1) / cellSize;
+
+	// each cell has a color index (or a color, for photo-like images) and flags
+	std::vector<uint32_t> cells((size_t) cellsX * cellsY);
+	std::vector<uint8_t> flags(cells.size());
+	static const uint8_t DITHERED = 1, TRANSPARENT = 2;
+
+	for (uint32_t cy = 0; cy < cellsY; ++cy)
+		for (uint32_t cx = 0; cx < cellsX; ++cx)
+		{
+			size_t index = (size_t) cy * cellsX + cx;
+
+			// keeps the color of the left or upper neighbor unless an edge is created
+			if (corpus_random(state) % 100 >= spec.edgeDensity && (cx > 0 || cy > 0))
+			{
+				if (cx > 0 && (cy == 0 || corpus_random(state) % 2))
+				{
+					cells[index] = cells[index - 1];
+					flags[index] = flags[index - 1];
+				}
+				else
+				{
+					cells[index] = cells[index - cellsX];
+					flags[index] = flags[index - cellsX];
+				}
+				continue;
+			}
+
+			cells[index] = corpus_random(state);
+			flags[index] = 0;
+			if (corpus_random(state) % 100 < spec.dithering) flags[index] |= DITHERED;
+			if (corpus_random(state) % 100 < spec.alpha) flags[index] |= TRANSPARENT;
+		}
+
+	image.resize((size_t) width * height);
+	for (uint32_t y = 0; y < height; ++y)
+		for (uint32_t x = 0; x < width; ++x)
+		{
+			size_t index = (size_t) (y / cellSize) * cellsX + x / cellSize;
+			uint32_t cell = cells[index];
+			uint32_t color;
+
+			if (flags[index] & TRANSPARENT)
+				color = 0;
+			else
+			if (palette.empty())
+			{
+				// smooth gradients with some noise
+				int noise = (int) (corpus_random(state) % 17) - 8;
+				int r = (int) ((cell & 0xFF) + x * 255 / width) / 2 + noise;
+				int g = (int) (((cell >> 8) & 0xFF) + y * 255 / height) / 2 + noise;
+				int b = (int) (((cell >> 16) & 0xFF) + (x + y) * 127 / (width + height)) / 2 + noise;
+				color = 0xFF000000 | (corpus_clamp(r) << 16) | (corpus_clamp(g) << 8) | corpus_clamp(b);
+			}
+			else
+			{
+				uint32_t first = cell % palette.size();
+				if ((flags[index] & DITHERED) && (x + y) % 2)
+					color = palette[(first + 1 + (cell >> 16) % palette.size()) % palette.size()];
+				else
+					color = palette[first];
+			}
+
+			image[(size_t) y * width + x] = color;
+		}
+}
+
+
+const std::vector<CorpusSpec> &Corpus::getClasses()
+{
+	static const CorpusSpec CLASSES[] =
+	{
+		// name         colors  edges  dither  alpha  seed
+		{ "flat",          4,      3,      0,     0,  0x1001 },
+		{ "pixelart",     16,     25,      5,     0,  0x1002 },
+		{ "dithered",     16,     25,     60,     0,  0x1003 },
+		{ "sprites",      16,     25,      5,    70,  0x1004 },
+		{ "photo",         0,     50,      0,     0,  0x1005 },
+		{ "noise",       256,    100,      0,     0,  0x1006 },
+	};
+	static const std::vector<CorpusSpec> classes(CLASSES,
+		CLASSES + sizeof(CLASSES) / sizeof(CorpusSpec));
+	return classes;
+}
+
+
+const std::vector<CorpusSize> &Corpus::getSizes()
+{
+	static const CorpusSize SIZES[] =
+	{
+		{ "snes",  256,  224 },
+		{ "vga",   320,  240 },
+		{ "hd",   1920, 1080 },
+		{ "4k",   3840, 2160 },
+		{ "8k",   7680, 4320 },
+	};
+	static const std::vector<CorpusSize> sizes(SIZES,
+		SIZES + sizeof(SIZES) / sizeof(CorpusSize));
+	return sizes;
+}
+
+
+bool Corpus::parseSize(
+	const std::string &text,
+	uint32_t &width,
+	uint32_t &height )
+{
+	const std::vector<CorpusSize> &sizes = getSizes();
+	for (size_t i = 0; i < sizes.size(); ++i)
+		if (text == sizes[i].name)
+		{
+			width = sizes[i].width;
+			height = sizes[i].height;
+			return true;
+		}
+
+	return sscanf(text.c_str(), "%ux%u", &width, &height) == 2 && width > 0 && height > 0;
+}
+
+
+int Corpus::savePam(
+	const std::string &fileName,
+	const uint32_t *image,
+	uint32_t width,
+	uint32_t height )
+{
+	FILE *output = fopen(fileName.c_str(), "wb");
+	if (output == NULL) return -1;
+
+	fprintf(output, "P7\nWIDTH %u\nHEIGHT %u\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n",
+		width, height);
+
+	std::vector<uint8_t> row(width * 4);
+	for (uint32_t y = 0; y < height; ++y)
+	{
+		for (uint32_t x = 0; x < width; ++x)
+		{
+			uint32_t value = image[(size_t) y * width + x];
+			row[x * 4]     = (uint8_t) (value >> 16);
+			row[x * 4 + 1] = (uint8_t) (value >> 8);
+			row[x * 4 + 2] = (uint8_t) value;
+			row[x * 4 + 3] = (uint8_t) (value >> 24);
+		}
+		fwrite(row.data(), 1, row.size(), output);
+	}
+
+	return (fclose(output) == 0) ? 0 : -1;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HQX_CORPUS_HH
+#define HQX_CORPUS_HH
+
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+
+/**
+ * @brief Content statistics of a synthetic image.
+ */
+struct CorpusSpec
+{
+	/// Name of the content class
+	const char *name;
+	/// Size of the palette (zero for photo-like images with smooth gradients)
+	uint32_t colors;
+	/// Percentage of color changes between neighbor cells (100 means noise)
+	uint32_t edgeDensity;
+	/// Percentage of the cells filled with a checkerboard of two colors
+	uint32_t dithering;
+	/// Percentage of the cells which are fully transparent
+	uint32_t alpha;
+	/// Seed of the pseudo-random generator
+	uint32_t seed;
+};
+
+
+/**
+ * @brief Image resolution with a name.
+ */
+struct CorpusSize
+{
+	const char *name;
+	uint32_t width;
+	uint32_t height;
+};
+
+
+/**
+ * @brief Deterministic generator of synthetic images used by the benchmarks and tests.
+ */
+class Corpus
+{
+	public:
+		/**
+		 * @brief Generates an ARGB image with the given content statistics. The
+		 * same specification and size always produce the same image.
+		 */
+		static void generate(
+			const CorpusSpec &spec,
+			uint32_t width,
+			uint32_t height,
+			std::vector<uint32_t> &image );
+
+		/**
+		 * @brief Returns the predefined content classes, from flat pixel art to noise.
+		 */
+		static const std::vector<CorpusSpec> &getClasses();
+
+		/**
+		 * @brief Returns the predefined resolutions, from emulator screens to 8K.
+		 */
+		static const std::vector<CorpusSize> &getSizes();
+
+		/**
+		 * @brief Parses a resolution given as "WIDTHxHEIGHT" or by the name of
+		 * a predefined one.
+		 */
+		static bool parseSize(
+			const std::string &text,
+			uint32_t &width,
+			uint32_t &height );
+
+		/**
+		 * @brief Saves the image as PAM (RGB_ALPHA).
+		 */
+		static int savePam(
+			const std::string &fileName,
+			const uint32_t *image,
+			uint32_t width,
+			uint32_t height );
+};
+
+
+#endif  // HQX_CORPUS_HH
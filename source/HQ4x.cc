@@ -0,0 +1,483 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hqx/HQ4x.hh>
+
+
+/*
+ * Rules applied to a 2x2 quadrant of the output block. The names refer to the
+ * neighbors of the quadrant: the diagonal neighbor (corner), the neighbor in the
+ * same column (vertical) and the neighbor in the same row (horizontal). Every
+ * rule corresponds to the pixels that one of the hq4x cases writes in the
+ * quadrant.
+ */
+enum
+{
+	CENTER,      // central pixel
+	SIDE_H,      // central pixel blended with the horizontal neighbor
+	SIDE_V,      // central pixel blended with the vertical neighbor
+	CORNER,      // central pixel blended with the corner
+	CORNER_H,    // corner and horizontal neighbor
+	CORNER_V,    // corner and vertical neighbor
+	BLEND,       // horizontal and vertical neighbors
+	SOFT,        // weaker version of BLEND
+	SUBTLE,      // weaker version of SOFT
+	DIAGONAL,    // diagonal edge between the horizontal and vertical neighbors
+	DIAGONAL_K,  // DIAGONAL with the inner pixel blended with the corner
+	LONG_H,      // start of an edge which continues in the quadrant of the same row
+	LONG_V,      // start of an edge which continues in the quadrant of the same column
+	TAIL_H,      // end of an edge which starts in the quadrant of the same row
+	TAIL_V       // end of an edge which starts in the quadrant of the same column
+};
+
+/*
+ * Selects the rule of a quadrant using the color comparison of one of the
+ * edges: the rule 'D' is used if the colors are different and 'S' otherwise.
+ */
+#define QUAD_IF(E,D,S)  (uint16_t) ( (((E) + 1) << 8) | ((S) << 4) | (D) )
+
+// pairs of neighbors compared by the edges used in QUAD_IF
+static const int QUAD_EDGES[4][2] = { {3, 1}, {1, 5}, {7, 3}, {5, 7} };
+
+// corner, vertical and horizontal neighbors of each quadrant
+static const int QUAD_NEIGHBORS[4][3] = { {0, 1, 3}, {2, 1, 5}, {6, 7, 3}, {8, 7, 5} };
+
+/*
+ * Rules of the top-left, top-right, bottom-left and bottom-right quadrants for
+ * each pattern, following the cases of hq4x. The edges of LONG_H and LONG_V
+ * continue in the neighbor quadrant, whose rule is then TAIL_H or TAIL_V and
+ * depends on the same color comparison.
+ */
+static const uint16_t QUAD_RULES[256][4] =
+{
+	/*   0 */ { BLEND, BLEND, BLEND, BLEND },
+	/*   1 */ { BLEND, BLEND, BLEND, BLEND },
+	/*   2 */ { CORNER_H, CORNER_H, BLEND, BLEND },
+	/*   3 */ { SIDE_H, CORNER_H, BLEND, BLEND },
+	/*   4 */ { BLEND, BLEND, BLEND, BLEND },
+	/*   5 */ { BLEND, BLEND, BLEND, BLEND },
+	/*   6 */ { CORNER_H, SIDE_H, BLEND, BLEND },
+	/*   7 */ { SIDE_H, SIDE_H, BLEND, BLEND },
+	/*   8 */ { CORNER_V, BLEND, CORNER_V, BLEND },
+	/*   9 */ { SIDE_V, BLEND, CORNER_V, BLEND },
+	/*  10 */ { QUAD_IF(0, CORNER, DIAGONAL_K), CORNER_H, CORNER_V, BLEND },
+	/*  11 */ { QUAD_IF(0, CENTER, DIAGONAL), CORNER_H, CORNER_V, BLEND },
+	/*  12 */ { CORNER_V, BLEND, CORNER_V, BLEND },
+	/*  13 */ { SIDE_V, BLEND, CORNER_V, BLEND },
+	/*  14 */ { QUAD_IF(0, CORNER, LONG_H), QUAD_IF(0, SIDE_H, TAIL_H), CORNER_V, BLEND },
+	/*  15 */ { QUAD_IF(0, CENTER, LONG_H), QUAD_IF(0, SIDE_H, TAIL_H), CORNER_V, BLEND },
+	/*  16 */ { BLEND, CORNER_V, BLEND, CORNER_V },
+	/*  17 */ { BLEND, CORNER_V, BLEND, CORNER_V },
+	/*  18 */ { CORNER_H, QUAD_IF(1, CORNER, DIAGONAL_K), BLEND, CORNER_V },
+	/*  19 */ { QUAD_IF(1, SIDE_H, TAIL_H), QUAD_IF(1, CORNER, LONG_H), BLEND, CORNER_V },
+	/*  20 */ { BLEND, SIDE_V, BLEND, CORNER_V },
+	/*  21 */ { BLEND, SIDE_V, BLEND, CORNER_V },
+	/*  22 */ { CORNER_H, QUAD_IF(1, CENTER, DIAGONAL), BLEND, CORNER_V },
+	/*  23 */ { QUAD_IF(1, SIDE_H, TAIL_H), QUAD_IF(1, CENTER, LONG_H), BLEND, CORNER_V },
+	/*  24 */ { CORNER_V, CORNER_V, CORNER_V, CORNER_V },
+	/*  25 */ { SIDE_V, CORNER_V, CORNER_V, CORNER_V },
+	/*  26 */ { QUAD_IF(0, CENTER, DIAGONAL), QUAD_IF(1, CENTER, DIAGONAL), CORNER_V, CORNER_V },
+	/*  27 */ { QUAD_IF(0, CENTER, DIAGONAL), CORNER, CORNER_V, CORNER_V },
+	/*  28 */ { CORNER_V, SIDE_V, CORNER_V, CORNER_V },
+	/*  29 */ { SIDE_V, SIDE_V, CORNER_V, CORNER_V },
+	/*  30 */ { CORNER, QUAD_IF(1, CENTER, DIAGONAL), CORNER_V, CORNER_V },
+	/*  31 */ { QUAD_IF(0, CENTER, DIAGONAL), QUAD_IF(1, CENTER, DIAGONAL), CORNER_V, CORNER_V },
+	/*  32 */ { BLEND, BLEND, BLEND, BLEND },
+	/*  33 */ { BLEND, BLEND, BLEND, BLEND },
+	/*  34 */ { CORNER_H, CORNER_H, BLEND, BLEND },
+	/*  35 */ { SIDE_H, CORNER_H, BLEND, BLEND },
+	/*  36 */ { BLEND, BLEND, BLEND, BLEND },
+	/*  37 */ { BLEND, BLEND, BLEND, BLEND },
+	/*  38 */ { CORNER_H, SIDE_H, BLEND, BLEND },
+	/*  39 */ { SIDE_H, SIDE_H, BLEND, BLEND },
+	/*  40 */ { CORNER_V, BLEND, SIDE_V, BLEND },
+	/*  41 */ { SIDE_V, BLEND, SIDE_V, BLEND },
+	/*  42 */ { QUAD_IF(0, CORNER, LONG_V), CORNER_H, QUAD_IF(0, SIDE_V, TAIL_V), BLEND },
+	/*  43 */ { QUAD_IF(0, CENTER, LONG_V), CORNER_H, QUAD_IF(0, SIDE_V, TAIL_V), BLEND },
+	/*  44 */ { CORNER_V, BLEND, SIDE_V, BLEND },
+	/*  45 */ { SIDE_V, BLEND, SIDE_V, BLEND },
+	/*  46 */ { QUAD_IF(0, CORNER, SOFT), SIDE_H, SIDE_V, BLEND },
+	/*  47 */ { QUAD_IF(0, CENTER, SUBTLE), SIDE_H, SIDE_V, BLEND },
+	/*  48 */ { BLEND, CORNER_V, BLEND, CORNER_V },
+	/*  49 */ { BLEND, CORNER_V, BLEND, CORNER_V },
+	/*  50 */ { CORNER_H, QUAD_IF(1, CORNER, DIAGONAL_K), BLEND, CORNER_V },
+	/*  51 */ { QUAD_IF(1, SIDE_H, TAIL_H), QUAD_IF(1, CORNER, LONG_H), BLEND, CORNER_V },
+	/*  52 */ { BLEND, SIDE_V, BLEND, CORNER_V },
+	/*  53 */ { BLEND, SIDE_V, BLEND, CORNER_V },
+	/*  54 */ { CORNER_H, QUAD_IF(1, CENTER, DIAGONAL), BLEND, CORNER_V },
+	/*  55 */ { QUAD_IF(1, SIDE_H, TAIL_H), QUAD_IF(1, CENTER, LONG_H), BLEND, CORNER_V },
+	/*  56 */ { CORNER_V, CORNER_V, SIDE_V, CORNER_V },
+	/*  57 */ { SIDE_V, CORNER_V, SIDE_V, CORNER_V },
+	/*  58 */ { QUAD_IF(0, CORNER, SOFT), QUAD_IF(1, CORNER, SOFT), SIDE_V, CORNER_V },
+	/*  59 */ { QUAD_IF(0, CENTER, DIAGONAL), QUAD_IF(1, CORNER, SOFT), SIDE_V, CORNER_V },
+	/*  60 */ { CORNER_V, SIDE_V, SIDE_V, CORNER_V },
+	/*  61 */ { SIDE_V, SIDE_V, SIDE_V, CORNER_V },
+	/*  62 */ { CORNER, QUAD_IF(1, CENTER, DIAGONAL), SIDE_V, CORNER_V },
+	/*  63 */ { QUAD_IF(0, CENTER, SUBTLE), QUAD_IF(1, CENTER, DIAGONAL), SIDE_V, CORNER_V },
+	/*  64 */ { BLEND, BLEND, CORNER_H, CORNER_H },
+	/*  65 */ { BLEND, BLEND, CORNER_H, CORNER_H },
+	/*  66 */ { CORNER_H, CORNER_H, CORNER_H, CORNER_H },
+	/*  67 */ { SIDE_H, CORNER_H, CORNER_H, CORNER_H },
+	/*  68 */ { BLEND, BLEND, CORNER_H, CORNER_H },
+	/*  69 */ { BLEND, BLEND, CORNER_H, CORNER_H },
+	/*  70 */ { CORNER_H, SIDE_H, CORNER_H, CORNER_H },
+	/*  71 */ { SIDE_H, SIDE_H, CORNER_H, CORNER_H },
+	/*  72 */ { CORNER_V, BLEND, QUAD_IF(2, CORNER, DIAGONAL_K), CORNER_H },
+	/*  73 */ { QUAD_IF(2, SIDE_V, TAIL_V), BLEND, QUAD_IF(2, CORNER, LONG_V), CORNER_H },
+	/*  74 */ { QUAD_IF(0, CENTER, DIAGONAL), CORNER_H, QUAD_IF(2, CENTER, DIAGONAL), CORNER_H },
+	/*  75 */ { QUAD_IF(0, CENTER, DIAGONAL), CORNER_H, CORNER, CORNER_H },
+	/*  76 */ { CORNER_V, BLEND, QUAD_IF(2, CORNER, DIAGONAL_K), CORNER_H },
+	/*  77 */ { QUAD_IF(2, SIDE_V, TAIL_V), BLEND, QUAD_IF(2, CORNER, LONG_V), CORNER_H },
+	/*  78 */ { QUAD_IF(0, CORNER, SOFT), SIDE_H, QUAD_IF(2, CORNER, SOFT), CORNER_H },
+	/*  79 */ { QUAD_IF(0, CENTER, DIAGONAL), SIDE_H, QUAD_IF(2, CORNER, SOFT), CORNER_H },
+	/*  80 */ { BLEND, CORNER_V, CORNER_H, QUAD_IF(3, CORNER, DIAGONAL_K) },
+	/*  81 */ { BLEND, CORNER_V, CORNER_H, QUAD_IF(3, CORNER, DIAGONAL_K) },
+	/*  82 */ { CORNER_H, QUAD_IF(1, CENTER, DIAGONAL), CORNER_H, QUAD_IF(3, CENTER, DIAGONAL) },
+	/*  83 */ { SIDE_H, QUAD_IF(1, CORNER, SOFT), CORNER_H, QUAD_IF(3, CORNER, SOFT) },
+	/*  84 */ { BLEND, QUAD_IF(3, SIDE_V, TAIL_V), CORNER_H, QUAD_IF(3, CORNER, LONG_V) },
+	/*  85 */ { BLEND, QUAD_IF(3, SIDE_V, TAIL_V), CORNER_H, QUAD_IF(3, CORNER, LONG_V) },
+	/*  86 */ { CORNER_H, QUAD_IF(1, CENTER, DIAGONAL), CORNER_H, CORNER },
+	/*  87 */ { SIDE_H, QUAD_IF(1, CENTER, DIAGONAL), CORNER_H, QUAD_IF(3, CORNER, SOFT) },
+	/*  88 */ { CORNER_V, CORNER_V, QUAD_IF(2, CENTER, DIAGONAL), QUAD_IF(3, CENTER, DIAGONAL) },
+	/*  89 */ { SIDE_V, CORNER_V, QUAD_IF(2, CORNER, SOFT), QUAD_IF(3, CORNER, SOFT) },
+	/*  90 */ { QUAD_IF(0, CORNER, SOFT), QUAD_IF(1, CORNER, SOFT), QUAD_IF(2, CORNER, SOFT), QUAD_IF(3, CORNER, SOFT) },
+	/*  91 */ { QUAD_IF(0, CENTER, DIAGONAL), QUAD_IF(1, CORNER, SOFT), QUAD_IF(2, CORNER, SOFT), QUAD_IF(3, CORNER, SOFT) },
+	/*  92 */ { CORNER_V, SIDE_V, QUAD_IF(2, CORNER, SOFT), QUAD_IF(3, CORNER, SOFT) },
+	/*  93 */ { SIDE_V, SIDE_V, QUAD_IF(2, CORNER, SOFT), QUAD_IF(3, CORNER, SOFT) },
+	/*  94 */ { QUAD_IF(0, CORNER, SOFT), QUAD_IF(1, CENTER, DIAGONAL), QUAD_IF(2, CORNER, SOFT), QUAD_IF(3, CORNER, SOFT) },
+	/*  95 */ { QUAD_IF(0, CENTER, DIAGONAL), QUAD_IF(1, CENTER, DIAGONAL), CORNER, CORNER },
+	/*  96 */ { BLEND, BLEND, SIDE_H, CORNER_H },
+	/*  97 */ { BLEND, BLEND, SIDE_H, CORNER_H },
+	/*  98 */ { CORNER_H, CORNER_H, SIDE_H, CORNER_H },
+	/*  99 */ { SIDE_H, CORNER_H, SIDE_H, CORNER_H },
+	/* 100 */ { BLEND, BLEND, SIDE_H, CORNER_H },
+	/* 101 */ { BLEND, BLEND, SIDE_H, CORNER_H },
+	/* 102 */ { CORNER_H, SIDE_H, SIDE_H, CORNER_H },
+	/* 103 */ { SIDE_H, SIDE_H, SIDE_H, CORNER_H },
+	/* 104 */ { CORNER_V, BLEND, QUAD_IF(2, CENTER, DIAGONAL), CORNER_H },
+	/* 105 */ { QUAD_IF(2, SIDE_V, TAIL_V), BLEND, QUAD_IF(2, CENTER, LONG_V), CORNER_H },
+	/* 106 */ { CORNER, CORNER_H, QUAD_IF(2, CENTER, DIAGONAL), CORNER_H },
+	/* 107 */ { QUAD_IF(0, CENTER, DIAGONAL), CORNER_H, QUAD_IF(2, CENTER, DIAGONAL), CORNER_H },
+	/* 108 */ { CORNER_V, BLEND, QUAD_IF(2, CENTER, DIAGONAL), CORNER_H },
+	/* 109 */ { QUAD_IF(2, SIDE_V, TAIL_V), BLEND, QUAD_IF(2, CENTER, LONG_V), CORNER_H },
+	/* 110 */ { CORNER, SIDE_H, QUAD_IF(2, CENTER, DIAGONAL), CORNER_H },
+	/* 111 */ { QUAD_IF(0, CENTER, SUBTLE), SIDE_H, QUAD_IF(2, CENTER, DIAGONAL), CORNER_H },
+	/* 112 */ { BLEND, CORNER_V, QUAD_IF(3, SIDE_H, TAIL_H), QUAD_IF(3, CORNER, LONG_H) },
+	/* 113 */ { BLEND, CORNER_V, QUAD_IF(3, SIDE_H, TAIL_H), QUAD_IF(3, CORNER, LONG_H) },
+	/* 114 */ { CORNER_H, QUAD_IF(1, CORNER, SOFT), SIDE_H, QUAD_IF(3, CORNER, SOFT) },
+	/* 115 */ { SIDE_H, QUAD_IF(1, CORNER, SOFT), SIDE_H, QUAD_IF(3, CORNER, SOFT) },
+	/* 116 */ { BLEND, SIDE_V, SIDE_H, QUAD_IF(3, CORNER, SOFT) },
+	/* 117 */ { BLEND, SIDE_V, SIDE_H, QUAD_IF(3, CORNER, SOFT) },
+	/* 118 */ { CORNER_H, QUAD_IF(1, CENTER, DIAGONAL), SIDE_H, CORNER },
+	/* 119 */ { QUAD_IF(1, SIDE_H, TAIL_H), QUAD_IF(1, CENTER, LONG_H), SIDE_H, CORNER },
+	/* 120 */ { CORNER_V, CORNER_V, QUAD_IF(2, CENTER, DIAGONAL), CORNER },
+	/* 121 */ { SIDE_V, CORNER_V, QUAD_IF(2, CENTER, DIAGONAL), QUAD_IF(3, CORNER, SOFT) },
+	/* 122 */ { QUAD_IF(0, CORNER, SOFT), QUAD_IF(1, CORNER, SOFT), QUAD_IF(2, CENTER, DIAGONAL), QUAD_IF(3, CORNER, SOFT) },
+	/* 123 */ { QUAD_IF(0, CENTER, DIAGONAL), CORNER, QUAD_IF(2, CENTER, DIAGONAL), CORNER },
+	/* 124 */ { CORNER_V, SIDE_V, QUAD_IF(2, CENTER, DIAGONAL), CORNER },
+	/* 125 */ { QUAD_IF(2, SIDE_V, TAIL_V), SIDE_V, QUAD_IF(2, CENTER, LONG_V), CORNER },
+	/* 126 */ { CORNER, QUAD_IF(1, CENTER, DIAGONAL), QUAD_IF(2, CENTER, DIAGONAL), CORNER },
+	/* 127 */ { QUAD_IF(0, CENTER, SUBTLE), QUAD_IF(1, CENTER, DIAGONAL), QUAD_IF(2, CENTER, DIAGONAL), CORNER },
+	/* 128 */ { BLEND, BLEND, BLEND, BLEND },
+	/* 129 */ { BLEND, BLEND, BLEND, BLEND },
+	/* 130 */ { CORNER_H, CORNER_H, BLEND, BLEND },
+	/* 131 */ { SIDE_H, CORNER_H, BLEND, BLEND },
+	/* 132 */ { BLEND, BLEND, BLEND, BLEND },
+	/* 133 */ { BLEND, BLEND, BLEND, BLEND },
+	/* 134 */ { CORNER_H, SIDE_H, BLEND, BLEND },
+	/* 135 */ { SIDE_H, SIDE_H, BLEND, BLEND },
+	/* 136 */ { CORNER_V, BLEND, CORNER_V, BLEND },
+	/* 137 */ { SIDE_V, BLEND, CORNER_V, BLEND },
+	/* 138 */ { QUAD_IF(0, CORNER, DIAGONAL_K), CORNER_H, CORNER_V, BLEND },
+	/* 139 */ { QUAD_IF(0, CENTER, DIAGONAL), CORNER_H, CORNER_V, BLEND },
+	/* 140 */ { CORNER_V, BLEND, CORNER_V, BLEND },
+	/* 141 */ { SIDE_V, BLEND, CORNER_V, BLEND },
+	/* 142 */ { QUAD_IF(0, CORNER, LONG_H), QUAD_IF(0, SIDE_H, TAIL_H), CORNER_V, BLEND },
+	/* 143 */ { QUAD_IF(0, CENTER, LONG_H), QUAD_IF(0, SIDE_H, TAIL_H), CORNER_V, BLEND },
+	/* 144 */ { BLEND, CORNER_V, BLEND, SIDE_V },
+	/* 145 */ { BLEND, CORNER_V, BLEND, SIDE_V },
+	/* 146 */ { CORNER_H, QUAD_IF(1, CORNER, LONG_V), BLEND, QUAD_IF(1, SIDE_V, TAIL_V) },
+	/* 147 */ { SIDE_H, QUAD_IF(1, CORNER, SOFT), BLEND, SIDE_V },
+	/* 148 */ { BLEND, SIDE_V, BLEND, SIDE_V },
+	/* 149 */ { BLEND, SIDE_V, BLEND, SIDE_V },
+	/* 150 */ { CORNER_H, QUAD_IF(1, CENTER, LONG_V), BLEND, QUAD_IF(1, SIDE_V, TAIL_V) },
+	/* 151 */ { SIDE_H, QUAD_IF(1, CENTER, SUBTLE), BLEND, SIDE_V },
+	/* 152 */ { CORNER_V, CORNER_V, CORNER_V, SIDE_V },
+	/* 153 */ { SIDE_V, CORNER_V, CORNER_V, SIDE_V },
+	/* 154 */ { QUAD_IF(0, CORNER, SOFT), QUAD_IF(1, CORNER, SOFT), CORNER_V, SIDE_V },
+	/* 155 */ { QUAD_IF(0, CENTER, DIAGONAL), CORNER, CORNER_V, SIDE_V },
+	/* 156 */ { CORNER_V, SIDE_V, CORNER_V, SIDE_V },
+	/* 157 */ { SIDE_V, SIDE_V, CORNER_V, SIDE_V },
+	/* 158 */ { QUAD_IF(0, CORNER, SOFT), QUAD_IF(1, CENTER, DIAGONAL), CORNER_V, SIDE_V },
+	/* 159 */ { QUAD_IF(0, CENTER, DIAGONAL), QUAD_IF(1, CENTER, SUBTLE), CORNER_V, SIDE_V },
+	/* 160 */ { BLEND, BLEND, BLEND, BLEND },
+	/* 161 */ { BLEND, BLEND, BLEND, BLEND },
+	/* 162 */ { CORNER_H, CORNER_H, BLEND, BLEND },
+	/* 163 */ { SIDE_H, CORNER_H, BLEND, BLEND },
+	/* 164 */ { BLEND, BLEND, BLEND, BLEND },
+	/* 165 */ { BLEND, BLEND, BLEND, BLEND },
+	/* 166 */ { CORNER_H, SIDE_H, BLEND, BLEND },
+	/* 167 */ { SIDE_H, SIDE_H, BLEND, BLEND },
+	/* 168 */ { CORNER_V, BLEND, SIDE_V, BLEND },
+	/* 169 */ { SIDE_V, BLEND, SIDE_V, BLEND },
+	/* 170 */ { QUAD_IF(0, CORNER, LONG_V), CORNER_H, QUAD_IF(0, SIDE_V, TAIL_V), BLEND },
+	/* 171 */ { QUAD_IF(0, CENTER, LONG_V), CORNER_H, QUAD_IF(0, SIDE_V, TAIL_V), BLEND },
+	/* 172 */ { CORNER_V, BLEND, SIDE_V, BLEND },
+	/* 173 */ { SIDE_V, BLEND, SIDE_V, BLEND },
+	/* 174 */ { QUAD_IF(0, CORNER, SOFT), SIDE_H, SIDE_V, BLEND },
+	/* 175 */ { QUAD_IF(0, CENTER, SUBTLE), SIDE_H, SIDE_V, BLEND },
+	/* 176 */ { BLEND, CORNER_V, BLEND, SIDE_V },
+	/* 177 */ { BLEND, CORNER_V, BLEND, SIDE_V },
+	/* 178 */ { CORNER_H, QUAD_IF(1, CORNER, LONG_V), BLEND, QUAD_IF(1, SIDE_V, TAIL_V) },
+	/* 179 */ { SIDE_H, QUAD_IF(1, CORNER, SOFT), BLEND, SIDE_V },
+	/* 180 */ { BLEND, SIDE_V, BLEND, SIDE_V },
+	/* 181 */ { BLEND, SIDE_V, BLEND, SIDE_V },
+	/* 182 */ { CORNER_H, QUAD_IF(1, CENTER, LONG_V), BLEND, QUAD_IF(1, SIDE_V, TAIL_V) },
+	/* 183 */ { SIDE_H, QUAD_IF(1, CENTER, SUBTLE), BLEND, SIDE_V },
+	/* 184 */ { CORNER_V, CORNER_V, SIDE_V, SIDE_V },
+	/* 185 */ { SIDE_V, CORNER_V, SIDE_V, SIDE_V },
+	/* 186 */ { QUAD_IF(0, CORNER, SOFT), QUAD_IF(1, CORNER, SOFT), SIDE_V, SIDE_V },
+	/* 187 */ { QUAD_IF(0, CENTER, LONG_V), CORNER, QUAD_IF(0, SIDE_V, TAIL_V), SIDE_V },
+	/* 188 */ { CORNER_V, SIDE_V, SIDE_V, SIDE_V },
+	/* 189 */ { SIDE_V, SIDE_V, SIDE_V, SIDE_V },
+	/* 190 */ { CORNER, QUAD_IF(1, CENTER, LONG_V), SIDE_V, QUAD_IF(1, SIDE_V, TAIL_V) },
+	/* 191 */ { QUAD_IF(0, CENTER, SUBTLE), QUAD_IF(1, CENTER, SUBTLE), SIDE_V, SIDE_V },
+	/* 192 */ { BLEND, BLEND, CORNER_H, SIDE_H },
+	/* 193 */ { BLEND, BLEND, CORNER_H, SIDE_H },
+	/* 194 */ { CORNER_H, CORNER_H, CORNER_H, SIDE_H },
+	/* 195 */ { SIDE_H, CORNER_H, CORNER_H, SIDE_H },
+	/* 196 */ { BLEND, BLEND, CORNER_H, SIDE_H },
+	/* 197 */ { BLEND, BLEND, CORNER_H, SIDE_H },
+	/* 198 */ { CORNER_H, SIDE_H, CORNER_H, SIDE_H },
+	/* 199 */ { SIDE_H, SIDE_H, CORNER_H, SIDE_H },
+	/* 200 */ { CORNER_V, BLEND, QUAD_IF(2, CORNER, LONG_H), QUAD_IF(2, SIDE_H, TAIL_H) },
+	/* 201 */ { SIDE_V, BLEND, QUAD_IF(2, CORNER, SOFT), SIDE_H },
+	/* 202 */ { QUAD_IF(0, CORNER, SOFT), CORNER_H, QUAD_IF(2, CORNER, SOFT), SIDE_H },
+	/* 203 */ { QUAD_IF(0, CENTER, DIAGONAL), CORNER_H, CORNER, SIDE_H },
+	/* 204 */ { CORNER_V, BLEND, QUAD_IF(2, CORNER, LONG_H), QUAD_IF(2, SIDE_H, TAIL_H) },
+	/* 205 */ { SIDE_V, BLEND, QUAD_IF(2, CORNER, SOFT), SIDE_H },
+	/* 206 */ { QUAD_IF(0, CORNER, SOFT), SIDE_H, QUAD_IF(2, CORNER, SOFT), SIDE_H },
+	/* 207 */ { QUAD_IF(0, CENTER, LONG_H), QUAD_IF(0, SIDE_H, TAIL_H), CORNER, SIDE_H },
+	/* 208 */ { BLEND, CORNER_V, CORNER_H, QUAD_IF(3, CENTER, DIAGONAL) },
+	/* 209 */ { BLEND, CORNER_V, CORNER_H, QUAD_IF(3, CENTER, DIAGONAL) },
+	/* 210 */ { CORNER_H, CORNER, CORNER_H, QUAD_IF(3, CENTER, DIAGONAL) },
+	/* 211 */ { SIDE_H, CORNER, CORNER_H, QUAD_IF(3, CENTER, DIAGONAL) },
+	/* 212 */ { BLEND, QUAD_IF(3, SIDE_V, TAIL_V), CORNER_H, QUAD_IF(3, CENTER, LONG_V) },
+	/* 213 */ { BLEND, QUAD_IF(3, SIDE_V, TAIL_V), CORNER_H, QUAD_IF(3, CENTER, LONG_V) },
+	/* 214 */ { CORNER_H, QUAD_IF(1, CENTER, DIAGONAL), CORNER_H, QUAD_IF(3, CENTER, DIAGONAL) },
+	/* 215 */ { SIDE_H, QUAD_IF(1, CENTER, SUBTLE), CORNER_H, QUAD_IF(3, CENTER, DIAGONAL) },
+	/* 216 */ { CORNER_V, CORNER_V, CORNER, QUAD_IF(3, CENTER, DIAGONAL) },
+	/* 217 */ { SIDE_V, CORNER_V, CORNER, QUAD_IF(3, CENTER, DIAGONAL) },
+	/* 218 */ { QUAD_IF(0, CORNER, SOFT), QUAD_IF(1, CORNER, SOFT), QUAD_IF(2, CORNER, SOFT), QUAD_IF(3, CENTER, DIAGONAL) },
+	/* 219 */ { QUAD_IF(0, CENTER, DIAGONAL), CORNER, CORNER, QUAD_IF(3, CENTER, DIAGONAL) },
+	/* 220 */ { CORNER_V, SIDE_V, QUAD_IF(2, CORNER, SOFT), QUAD_IF(3, CENTER, DIAGONAL) },
+	/* 221 */ { SIDE_V, QUAD_IF(3, SIDE_V, TAIL_V), CORNER, QUAD_IF(3, CENTER, LONG_V) },
+	/* 222 */ { CORNER, QUAD_IF(1, CENTER, DIAGONAL), CORNER, QUAD_IF(3, CENTER, DIAGONAL) },
+	/* 223 */ { QUAD_IF(0, CENTER, DIAGONAL), QUAD_IF(1, CENTER, SUBTLE), CORNER, QUAD_IF(3, CENTER, DIAGONAL) },
+	/* 224 */ { BLEND, BLEND, SIDE_H, SIDE_H },
+	/* 225 */ { BLEND, BLEND, SIDE_H, SIDE_H },
+	/* 226 */ { CORNER_H, CORNER_H, SIDE_H, SIDE_H },
+	/* 227 */ { SIDE_H, CORNER_H, SIDE_H, SIDE_H },
+	/* 228 */ { BLEND, BLEND, SIDE_H, SIDE_H },
+	/* 229 */ { BLEND, BLEND, SIDE_H, SIDE_H },
+	/* 230 */ { CORNER_H, SIDE_H, SIDE_H, SIDE_H },
+	/* 231 */ { SIDE_H, SIDE_H, SIDE_H, SIDE_H },
+	/* 232 */ { CORNER_V, BLEND, QUAD_IF(2, CENTER, LONG_H), QUAD_IF(2, SIDE_H, TAIL_H) },
+	/* 233 */ { SIDE_V, BLEND, QUAD_IF(2, CENTER, SUBTLE), SIDE_H },
+	/* 234 */ { QUAD_IF(0, CORNER, SOFT), CORNER_H, QUAD_IF(2, CENTER, DIAGONAL), SIDE_H },
+	/* 235 */ { QUAD_IF(0, CENTER, DIAGONAL), CORNER_H, QUAD_IF(2, CENTER, SUBTLE), SIDE_H },
+	/* 236 */ { CORNER_V, BLEND, QUAD_IF(2, CENTER, LONG_H), QUAD_IF(2, SIDE_H, TAIL_H) },
+	/* 237 */ { SIDE_V, BLEND, QUAD_IF(2, CENTER, SUBTLE), SIDE_H },
+	/* 238 */ { CORNER, SIDE_H, QUAD_IF(2, CENTER, LONG_H), QUAD_IF(2, SIDE_H, TAIL_H) },
+	/* 239 */ { QUAD_IF(0, CENTER, SUBTLE), SIDE_H, QUAD_IF(2, CENTER, SUBTLE), SIDE_H },
+	/* 240 */ { BLEND, CORNER_V, QUAD_IF(3, SIDE_H, TAIL_H), QUAD_IF(3, CENTER, LONG_H) },
+	/* 241 */ { BLEND, CORNER_V, QUAD_IF(3, SIDE_H, TAIL_H), QUAD_IF(3, CENTER, LONG_H) },
+	/* 242 */ { CORNER_H, QUAD_IF(1, CORNER, SOFT), SIDE_H, QUAD_IF(3, CENTER, DIAGONAL) },
+	/* 243 */ { SIDE_H, CORNER, QUAD_IF(3, SIDE_H, TAIL_H), QUAD_IF(3, CENTER, LONG_H) },
+	/* 244 */ { BLEND, SIDE_V, SIDE_H, QUAD_IF(3, CENTER, SUBTLE) },
+	/* 245 */ { BLEND, SIDE_V, SIDE_H, QUAD_IF(3, CENTER, SUBTLE) },
+	/* 246 */ { CORNER_H, QUAD_IF(1, CENTER, DIAGONAL), SIDE_H, QUAD_IF(3, CENTER, SUBTLE) },
+	/* 247 */ { SIDE_H, QUAD_IF(1, CENTER, SUBTLE), SIDE_H, QUAD_IF(3, CENTER, SUBTLE) },
+	/* 248 */ { CORNER_V, CORNER_V, QUAD_IF(2, CENTER, DIAGONAL), QUAD_IF(3, CENTER, DIAGONAL) },
+	/* 249 */ { SIDE_V, CORNER_V, QUAD_IF(2, CENTER, SUBTLE), QUAD_IF(3, CENTER, DIAGONAL) },
+	/* 250 */ { CORNER, CORNER, QUAD_IF(2, CENTER, DIAGONAL), QUAD_IF(3, CENTER, DIAGONAL) },
+	/* 251 */ { QUAD_IF(0, CENTER, DIAGONAL), CORNER, QUAD_IF(2, CENTER, SUBTLE), QUAD_IF(3, CENTER, DIAGONAL) },
+	/* 252 */ { CORNER_V, SIDE_V, QUAD_IF(2, CENTER, DIAGONAL), QUAD_IF(3, CENTER, SUBTLE) },
+	/* 253 */ { SIDE_V, SIDE_V, QUAD_IF(2, CENTER, SUBTLE), QUAD_IF(3, CENTER, SUBTLE) },
+	/* 254 */ { CORNER, QUAD_IF(1, CENTER, DIAGONAL), QUAD_IF(2, CENTER, DIAGONAL), QUAD_IF(3, CENTER, SUBTLE) },
+	/* 255 */ { QUAD_IF(0, CENTER, SUBTLE), QUAD_IF(1, CENTER, SUBTLE), QUAD_IF(2, CENTER, SUBTLE), QUAD_IF(3, CENTER, SUBTLE) }
+};
+
+
+HQ4x::HQ4x()
+{
+	// nothing to do
+}
+
+
+HQ4x::~HQ4x()
+{
+	// nothing to do
+}
+
+
+uint32_t HQ4x::getFactor() const
+{
+	return 4;
+}
+
+
+uint32_t *HQ4x::resize(
+	const uint32_t *image,
+	uint32_t width,
+	uint32_t height,
+	uint32_t *output,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA,
+	bool wrapX,
+	bool wrapY ) const
+{
+	return resizeRows(image, width, height, output, 0, height, trY, trU, trV, trA, wrapX, wrapY);
+}
+
+
+void HQ4x::interpolate(
+	int pattern,
+	const uint32_t *w,
+	uint32_t *output,
+	int lineSize,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA ) const
+{
+	const uint16_t *rules = QUAD_RULES[pattern];
+	// result of the comparison of each edge (-1 if not compared yet)
+	int edges[4] = { -1, -1, -1, -1 };
+	uint32_t c = w[4];
+
+	for (int q = 0; q < 4; ++q)
+	{
+		uint32_t rule = rules[q];
+		if (rule > 0xFF)
+		{
+			int edge = (int) (rule >> 8) - 1;
+			if (edges[edge] < 0)
+				edges[edge] = HQx::isDifferent(w[ QUAD_EDGES[edge][0] ], w[ QUAD_EDGES[edge][1] ],
+					trY, trU, trV, trA);
+			rule = (edges[edge]) ? (rule & 0x0F) : ((rule >> 4) & 0x0F);
+		}
+
+		uint32_t k = w[ QUAD_NEIGHBORS[q][0] ];
+		uint32_t v = w[ QUAD_NEIGHBORS[q][1] ];
+		uint32_t h = w[ QUAD_NEIGHBORS[q][2] ];
+
+		/*
+		 * Pixels of the quadrant: 'o' is the outer corner of the block, 'a' is
+		 * next to it in the same row, 'b' in the same column and 'i' is the
+		 * pixel closer to the center of the block.
+		 */
+		uint32_t *outer = output + ((q < 2) ? 0 : lineSize * 3);
+		uint32_t *inner = output + ((q < 2) ? lineSize : lineSize * 2);
+		int outerCol = (q & 1) ? 3 : 0;
+		int innerCol = (q & 1) ? 2 : 1;
+		uint32_t &o = outer[outerCol];
+		uint32_t &a = outer[innerCol];
+		uint32_t &b = inner[outerCol];
+		uint32_t &i = inner[innerCol];
+
+		switch (rule)
+		{
+			case CENTER:
+				o = a = b = i = c;
+				break;
+			case SIDE_H:
+				o = b = HQX_MIX_2(c,h,5U,3U);
+				a = i = HQX_MIX_2(c,h,7U,1U);
+				break;
+			case SIDE_V:
+				o = a = HQX_MIX_2(c,v,5U,3U);
+				b = i = HQX_MIX_2(c,v,7U,1U);
+				break;
+			case CORNER:
+				o = HQX_MIX_2(c,k,5U,3U);
+				a = b = HQX_MIX_2(c,k,3U,1U);
+				i = HQX_MIX_2(c,k,7U,1U);
+				break;
+			case CORNER_H:
+				o = HQX_MIX_2(c,k,5U,3U);
+				a = HQX_MIX_2(c,k,3U,1U);
+				b = HQX_MIX_3(c,h,k,5U,2U,1U);
+				i = HQX_MIX_2(c,k,7U,1U);
+				break;
+			case CORNER_V:
+				o = HQX_MIX_2(c,k,5U,3U);
+				a = HQX_MIX_3(c,v,k,5U,2U,1U);
+				b = HQX_MIX_2(c,k,3U,1U);
+				i = HQX_MIX_2(c,k,7U,1U);
+				break;
+			case BLEND:
+				o = HQX_MIX_3(c,h,v,2U,1U,1U);
+				a = HQX_MIX_3(c,v,h,5U,2U,1U);
+				b = HQX_MIX_3(c,h,v,5U,2U,1U);
+				i = HQX_MIX_3(c,h,v,6U,1U,1U);
+				break;
+			case SOFT:
+				o = HQX_MIX_3(c,h,v,2U,1U,1U);
+				a = HQX_MIX_2(c,v,3U,1U);
+				b = HQX_MIX_2(c,h,3U,1U);
+				i = c;
+				break;
+			case SUBTLE:
+				o = HQX_MIX_3(c,h,v,2U,1U,1U);
+				a = b = i = c;
+				break;
+			case DIAGONAL:
+			case DIAGONAL_K:
+				o = HQX_MIX_2(h,v,1U,1U);
+				a = HQX_MIX_2(v,c,1U,1U);
+				b = HQX_MIX_2(h,c,1U,1U);
+				i = (rule == DIAGONAL) ? c : HQX_MIX_2(c,k,7U,1U);
+				break;
+			case LONG_H:
+				o = HQX_MIX_2(h,v,1U,1U);
+				a = HQX_MIX_2(v,h,5U,3U);
+				b = HQX_MIX_3(h,c,v,2U,1U,1U);
+				i = HQX_MIX_3(c,h,v,6U,1U,1U);
+				break;
+			case LONG_V:
+				o = HQX_MIX_2(h,v,1U,1U);
+				a = HQX_MIX_3(v,c,h,2U,1U,1U);
+				b = HQX_MIX_2(h,v,5U,3U);
+				i = HQX_MIX_3(c,h,v,6U,1U,1U);
+				break;
+			case TAIL_H:
+				o = HQX_MIX_2(c,v,3U,1U);
+				a = HQX_MIX_2(v,c,3U,1U);
+				b = HQX_MIX_2(c,h,5U,3U);
+				i = HQX_MIX_2(c,h,7U,1U);
+				break;
+			case TAIL_V:
+				o = HQX_MIX_2(c,h,3U,1U);
+				a = HQX_MIX_2(c,v,5U,3U);
+				b = HQX_MIX_2(h,c,3U,1U);
+				i = HQX_MIX_2(c,v,7U,1U);
+				break;
+		}
+	}
+}
@@ -15,7 +15,30 @@
  */
 
 #include <hqx/HQx.hh>
+#include <hqx/HQxFilter.hh>
+#include <hqx/ThreadPool.hh>
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <typeinfo>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HQX_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef HQX_STATS
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+#endif
 
 
 static const uint32_t AMASK = 0xFF000000;
@@ -23,15 +46,93 @@ static const uint32_t YMASK = 0x00FF0000;
 static const uint32_t UMASK = 0x0000FF00;
 static const uint32_t VMASK = 0x000000FF;
 
-HQx::HQx()
+// whether the colors compared by the current thread are already in AYUV
+static thread_local bool hqx_ayuv = false;
+
+// pairs of sides of the window compared by the interpolations (see HQx::getEdges)
+static const int HQX_SIDES[4][2] = { { 1, 5 }, { 5, 7 }, { 7, 3 }, { 3, 1 } };
+
+// terms of the blend of each output pixel in HQx::resizeGray
+static const uint32_t HQX_GRAY_TERMS = 3;
+
+/*
+ * Blends used by HQx::resizeGray. For each pattern and result of the comparisons
+ * between the sides of the window (pattern * 16 + edges), every output pixel of
+ * the block is the sum of HQX_GRAY_TERMS pixels of the window multiplied by their
+ * weights (in 1/16 units) and divided by 16, which is exactly what the
+ * interpolations do with each component of the colors.
+ */
+struct HQxGrayRules
 {
-	// nothing to do
+	uint32_t factor;
+	// window index and weight of the terms of every output pixel
+	std::vector<uint8_t> terms;
+};
+
+// window whose side comparisons are known in advance (see HQx::setEdges)
+static thread_local const uint32_t *hqx_window = NULL;
+static thread_local int hqx_edges = 0;
+
+/*
+ * Direct-mapped cache of the output blocks of recent windows, used when the
+ * memoization is enabled. Each entry has the generation in which it was
+ * written, the window, the thresholds, the pattern and the blocks of every
+ * scaler. The entries are kept between calls (e.g. the bands, sprites and
+ * tiles of one image) and the generation changes only when the types of the
+ * scalers, the color space or the quality are not the ones used to produce
+ * them.
+ */
+static const uint32_t HQX_MEMO_BITS = 10;
+static const uint32_t HQX_MEMO_HEADER = 15;
+static thread_local std::vector<uint32_t> hqx_memo;
+static thread_local uint32_t hqx_memoStride = 0;
+static thread_local uint32_t hqx_memoGeneration = 0;
+static thread_local std::vector<const std::type_info*> hqx_memoScalers;
+static thread_local uint32_t hqx_memoSettings = 0;
+
+#ifdef HQX_STATS
+
+struct HQxStatsData
+{
+	HQxStats stats;
+	uint32_t sampling;
+	std::mutex lock;
+};
+
+// number of color comparisons made by the current thread
+static thread_local uint64_t hqx_checks = 0;
+
+
+static inline uint64_t hqx_cycles()
+{
+#if defined(_MSC_VER) || defined(__i386__) || defined(__x86_64__)
+	return __rdtsc();
+#else
+	return (uint64_t) std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+#endif
+
+
+HQx::HQx() : statsData(NULL), grayRules(NULL), transform(HQX_IDENTITY), filter(NULL),
+	colorSpace(HQX_ARGB), alphaMode(HQX_ALPHA_STRAIGHT), memoization(false),
+	quality(HQX_QUALITY_FULL)
+{
+#ifdef HQX_STATS
+	statsData = new HQxStatsData();
+	statsData->sampling = 0;
+	resetStats();
+#endif
 }
 
 
 HQx::~HQx()
 {
-	// nothing to do
+	delete grayRules;
+#ifdef HQX_STATS
+	delete statsData;
+#endif
 }
 
 
@@ -52,13 +153,1323 @@ uint32_t HQx::ARGBtoAYUV(
 }
 
 
-#if (1)
+/*
+ * Computes the position of the pixel (0, 0) of an image with the given size in
+ * the transformed output and how much the position changes when moving one
+ * pixel in each direction. The stride is the number of pixels between the
+ * beginning of consecutive rows of the transformed output (zero if the rows
+ * are contiguous).
+ */
+static void hqx_steps(
+	HQxTransform transform,
+	uint32_t width,
+	uint32_t height,
+	uint32_t stride,
+	ptrdiff_t &origin,
+	ptrdiff_t &stepX,
+	ptrdiff_t &stepY )
+{
+	ptrdiff_t w = width;
+	ptrdiff_t h = height;
+	bool rotated = (transform == HQX_ROTATE_90 || transform == HQX_ROTATE_270);
+	ptrdiff_t line = (stride != 0) ? (ptrdiff_t) stride : (rotated ? h : w);
+
+	switch (transform)
+	{
+		case HQX_ROTATE_90:
+			origin = h - 1;
+			stepX = line;
+			stepY = -1;
+			break;
+		case HQX_ROTATE_180:
+			origin = (h - 1) * line + w - 1;
+			stepX = -1;
+			stepY = -line;
+			break;
+		case HQX_ROTATE_270:
+			origin = (w - 1) * line;
+			stepX = -line;
+			stepY = 1;
+			break;
+		case HQX_FLIP_H:
+			origin = w - 1;
+			stepX = -1;
+			stepY = line;
+			break;
+		case HQX_FLIP_V:
+			origin = (h - 1) * line;
+			stepX = 1;
+			stepY = -line;
+			break;
+		default:
+			origin = 0;
+			stepX = 1;
+			stepY = line;
+	}
+}
+
+
+/*
+ * Replaces the comparisons between the sides of the window made by the
+ * interpolations with equality checks (HQX_QUALITY_FAST).
+ */
+static inline void hqx_fastEdges(
+	const uint32_t *w )
+{
+	hqx_window = w;
+	hqx_edges = 0;
+	for (int i = 0; i < 4; ++i)
+		if (w[ HQX_SIDES[i][0] ] != w[ HQX_SIDES[i][1] ]) hqx_edges |= 1 << i;
+}
+
+
+/*
+ * Stores an output block interpolated in a temporary buffer with the given steps.
+ */
+static inline void hqx_store(
+	const uint32_t *block,
+	uint32_t factor,
+	uint32_t *output,
+	ptrdiff_t stepX,
+	ptrdiff_t stepY )
+{
+	for (uint32_t y = 0; y < factor; ++y)
+		for (uint32_t x = 0; x < factor; ++x)
+		{
+			ptrdiff_t offset = (ptrdiff_t) x * stepX + (ptrdiff_t) y * stepY;
+			output[offset] = block[y * factor + x];
+		}
+}
+
+
+uint32_t *HQx::resizeRows(
+	const uint32_t *image,
+	uint32_t width,
+	uint32_t height,
+	uint32_t *output,
+	uint32_t firstRow,
+	uint32_t lastRow,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA,
+	bool wrapX,
+	bool wrapY ) const
+{
+	return resizeRows(image, width, height, output, firstRow, lastRow, trY, trU, trV, trA, wrapX,
+		wrapY, quality);
+}
+
+
+uint32_t *HQx::resizeRows(
+	const uint32_t *image,
+	uint32_t width,
+	uint32_t height,
+	uint32_t *output,
+	uint32_t firstRow,
+	uint32_t lastRow,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA,
+	bool wrapX,
+	bool wrapY,
+	HQxQuality quality ) const
+{
+	const HQx *scaler = this;
+	uint32_t factor = getFactor();
+	ptrdiff_t origin, stepX, stepY;
+	hqx_steps(transform, width * factor, height * factor, 0, origin, stepX, stepY);
+	uint32_t *first = output + origin + (ptrdiff_t) (firstRow * factor) * stepY;
+	processRows(&scaler, 1, image, width, height, width, &first, 0, firstRow, lastRow, 0, width,
+		trY, trU, trV, trA, wrapX, wrapY, true, colorSpace, alphaMode, quality, memoization);
+
+	return output + lastRow * width * getFactor() * getFactor();
+}
+
+
+void HQx::processRows(
+	const HQx *const *scalers,
+	uint32_t count,
+	const uint32_t *image,
+	uint32_t width,
+	uint32_t height,
+	uint32_t stride,
+	uint32_t *const *outputs,
+	uint32_t outputStride,
+	uint32_t firstRow,
+	uint32_t lastRow,
+	uint32_t firstCol,
+	uint32_t lastCol,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA,
+	bool wrapX,
+	bool wrapY,
+	bool useTransform,
+	HQxColorSpace colorSpace,
+	HQxAlphaMode alphaMode,
+	HQxQuality quality,
+	bool memoize )
+{
+	std::vector<uint32_t*> output(count);
+	std::vector<uint32_t> factor(count);
+	std::vector<ptrdiff_t> stepX(count), stepY(count);
+	// steps in the output, which differ from stepX and stepY with a filter
+	std::vector<ptrdiff_t> outputX(count), outputY(count);
+	std::vector<const HQxFilter*> filters(count);
+	// output of the current row of the filtered scalers
+	std::vector< std::vector<uint32_t> > strips(count);
+	std::vector<uint32_t> block;
+	// columns whose pixels in the previous, current and next rows are transparent
+	std::vector<uint8_t> clear;
+
+	int previous, next;
+	uint32_t w[9];
+
+	trY <<= 16;
+	trU <<= 8;
+	trA <<= 24;
+
+	// the comparisons are made by static functions called from the interpolations
+	bool ayuv = hqx_ayuv;
+	hqx_ayuv = (colorSpace == HQX_AYUV);
+	bool fast = (quality == HQX_QUALITY_FAST);
+	bool patterns = false;
+	for (uint32_t i = 0; i < count; ++i)
+		patterns |= scalers[i]->usesPattern();
+	fast &= patterns;
+	const uint32_t *window = hqx_window;
+	int edges = hqx_edges;
+
+	image += firstRow * stride + firstCol;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		factor[i] = scalers[i]->getFactor();
+		ptrdiff_t origin;
+		HQxTransform transform = (useTransform) ? scalers[i]->transform : HQX_IDENTITY;
+		hqx_steps(transform, width * factor[i], height * factor[i], outputStride, origin,
+			outputX[i], outputY[i]);
+		stepX[i] = outputX[i];
+		stepY[i] = outputY[i];
+		filters[i] = (useTransform) ? scalers[i]->filter : NULL;
+		// the blocks of a filtered scaler are written in a strip, which is filtered
+		// once for each output row (not for each block) and then stored
+		if (filters[i] != NULL)
+		{
+			stepX[i] = 1;
+			stepY[i] = (ptrdiff_t) (lastCol - firstCol) * factor[i];
+			strips[i].resize((size_t) stepY[i] * factor[i]);
+		}
+		// transformed blocks are interpolated in a temporary buffer
+		if (stepX[i] != 1 && block.size() < factor[i] * factor[i])
+			block.resize(factor[i] * factor[i]);
+	}
+
+	// the memoization is disabled for a while in the rows where it is not worth it
+	uint32_t memoStride = HQX_MEMO_HEADER;
+	uint32_t memoBackoff = 0, lookups = 0, hits = 0;
+	bool memoActive = false;
+	const uint32_t thresholds[4] = { trY, trU, trV, trA };
+	uint64_t memoSeed = 0;
+	if (memoize)
+	{
+		for (uint32_t i = 0; i < count; ++i)
+			memoStride += factor[i] * factor[i];
+		for (int k = 0; k < 4; ++k)
+			memoSeed = (memoSeed ^ thresholds[k]) * 0x9E3779B97F4A7C15ULL;
+
+		// the blocks depend only on the type of the scalers, not on the instances
+		std::vector<const std::type_info*> types(count);
+		for (uint32_t i = 0; i < count; ++i)
+			types[i] = &typeid(*scalers[i]);
+		uint32_t settings = (uint32_t) hqx_ayuv | ((uint32_t) fast << 1);
+		bool changed = hqx_memoSettings != settings || hqx_memoScalers != types;
+		if (hqx_memoStride != memoStride || (changed && ++hqx_memoGeneration == 0))
+		{
+			hqx_memo.assign((size_t) memoStride << HQX_MEMO_BITS, 0);
+			hqx_memoStride = memoStride;
+			hqx_memoGeneration = 1;
+		}
+		hqx_memoScalers.swap(types);
+		hqx_memoSettings = settings;
+	}
+
+	// with premultiplied alpha only the pixels that are entirely zero are skipped,
+	// so the skipped blocks are exactly what the interpolation would produce
+	bool skip = (alphaMode != HQX_ALPHA_STRAIGHT && colorSpace == HQX_ARGB);
+	uint32_t clearMask = (alphaMode == HQX_ALPHA_PREMULTIPLIED) ? 0xFFFFFFFF : 0xFF000000;
+	if (skip) clear.resize(width);
+	auto transparent = [&](uint32_t col) -> bool
+	{
+		uint32_t left  = (col > 0) ? col - 1 : (wrapX ? width - 1 : col);
+		uint32_t right = (col < width - 1) ? col + 1 : (wrapX ? 0 : col);
+		return clear[left] && clear[col] && clear[right];
+	};
+
+#ifdef HQX_STATS
+	// the counters are merged at the end to avoid contention between threads
+	std::vector<HQxStats> stats(count);
+	memset(stats.data(), 0, count * sizeof(HQxStats));
+	uint32_t counter = 0;
+#endif
+
+	// iterates between the lines
+	for (uint32_t row = firstRow; row < lastRow; row++)
+	{
+		/*
+		 * Note: this function uses a 3x3 sliding window over the original image.
+		 *
+		 *   +----+----+----+
+		 *   |    |    |    |
+		 *   | w0 | w1 | w2 |
+		 *   +----+----+----+
+		 *   |    |    |    |
+		 *   | w3 | w4 | w5 |
+		 *   +----+----+----+
+		 *   |    |    |    |
+		 *   | w6 | w7 | w8 |
+		 *   +----+----+----+
+		 */
+
+		for (uint32_t i = 0; i < count; ++i)
+			output[i] = (filters[i] != NULL) ? strips[i].data() :
+				outputs[i] + (ptrdiff_t) ((row - firstRow) * factor[i]) * stepY[i];
+
+		if (memoize)
+		{
+			// gives up for some rows if less than half of the windows were found
+			if (memoActive && lookups >= 64 && hits * 2 < lookups)
+				memoBackoff = 32;
+			memoActive = (memoBackoff == 0);
+			if (memoBackoff > 0) --memoBackoff;
+			lookups = hits = 0;
+		}
+
+		// adjusts the previous and next line pointers
+		if (row > 0)
+			previous = -stride;
+		else
+		{
+			if (wrapY)
+				previous = stride * (height - 1);
+			else
+				previous = 0;
+		}
+		if (row < height - 1)
+			next = stride;
+		else
+		{
+			if (wrapY)
+				next = -(stride * (height - 1));
+			else
+				next = 0;
+		}
+
+		if (skip)
+		{
+			const uint32_t *line = image - firstCol;
+			const uint32_t *above = line + previous;
+			const uint32_t *below = line + next;
+			for (uint32_t col = 0; col < width; col++)
+				clear[col] = ((above[col] | line[col] | below[col]) & clearMask) == 0;
+		}
+
+		// iterates between the columns
+		for (uint32_t col = firstCol; col < lastCol; col++)
+		{
+			if (skip && transparent(col))
+			{
+				// fills the whole run of pixels whose window is transparent
+				uint32_t run = 1;
+				while (col + run < lastCol && transparent(col + run))
+					++run;
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					uint32_t f = factor[i];
+					if (stepX[i] == 1)
+					{
+						for (uint32_t y = 0; y < f; ++y)
+							std::fill_n(output[i] + (ptrdiff_t) y * stepY[i], run * f, 0);
+					}
+					else
+					{
+						for (uint32_t x = 0; x < run; ++x)
+						{
+							std::fill_n(block.data(), f * f, 0);
+							hqx_store(block.data(), f, output[i] + (ptrdiff_t) (x * f) * stepX[i],
+								stepX[i], stepY[i]);
+						}
+					}
+					output[i] += (ptrdiff_t) (run * f) * stepX[i];
+				}
+				image += run;
+				col += run - 1;
+				continue;
+			}
+
+			w[1] = *(image + previous);
+			w[4] = *image;
+			w[7] = *(image + next);
+
+			if (col > 0)
+			{
+				w[0] = *(image + previous - 1);
+				w[3] = *(image - 1);
+				w[6] = *(image + next - 1);
+			}
+			else
+			{
+				if (wrapX)
+				{
+					w[0] = *(image + previous + width - 1);
+					w[3] = *(image + width - 1);
+					w[6] = *(image + next + width - 1);
+				}
+				else
+				{
+					w[0] = w[1];
+					w[3] = w[4];
+					w[6] = w[7];
+				}
+			}
+
+			if (col < width - 1)
+			{
+				w[2] = *(image + previous + 1);
+				w[5] = *(image + 1);
+				w[8] = *(image + next + 1);
+			}
+			else
+			{
+				if (wrapX)
+				{
+					w[2] = *(image + previous - width + 1);
+					w[5] = *(image - width + 1);
+					w[8] = *(image + next - width + 1);
+				}
+				else
+				{
+					w[2] = w[1];
+					w[5] = w[4];
+					w[8] = w[7];
+				}
+			}
+
+			if (memoActive)
+			{
+				uint64_t hash = memoSeed;
+				for (int k = 0; k < 9; ++k)
+					hash = (hash ^ w[k]) * 0x9E3779B97F4A7C15ULL;
+				uint32_t *entry = hqx_memo.data() + (hash >> (64 - HQX_MEMO_BITS)) * memoStride;
+				int pattern;
+				++lookups;
+				if (entry[0] == hqx_memoGeneration && memcmp(entry + 1, w, sizeof(w)) == 0 &&
+					memcmp(entry + 10, thresholds, sizeof(thresholds)) == 0)
+				{
+					pattern = (int) entry[14];
+					++hits;
+				}
+				else
+				{
+					if (fast) hqx_window = NULL;
+					pattern = (patterns) ? getPattern(w, trY, trU, trV, trA) : 0;
+					if (fast) hqx_fastEdges(w);
+					entry[0] = hqx_memoGeneration;
+					memcpy(entry + 1, w, sizeof(w));
+					memcpy(entry + 10, thresholds, sizeof(thresholds));
+					entry[14] = (uint32_t) pattern;
+					uint32_t *target = entry + HQX_MEMO_HEADER;
+					for (uint32_t i = 0; i < count; ++i)
+					{
+						scalers[i]->interpolate(pattern, w, target, factor[i], trY, trU, trV, trA);
+						target += factor[i] * factor[i];
+					}
+				}
+
+				const uint32_t *source = entry + HQX_MEMO_HEADER;
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					uint32_t f = factor[i];
+					if (stepX[i] == 1)
+					{
+						for (uint32_t y = 0; y < f; ++y)
+							memcpy(output[i] + (ptrdiff_t) y * stepY[i], source + y * f,
+								f * sizeof(uint32_t));
+					}
+					else
+					{
+						std::copy_n(source, f * f, block.data());
+						hqx_store(block.data(), f, output[i], stepX[i], stepY[i]);
+					}
+#ifdef HQX_STATS
+					stats[i].hits[pattern]++;
+#endif
+					source += f * f;
+					output[i] += factor[i] * stepX[i];
+				}
+				image++;
+				continue;
+			}
+
+			// the window and the pattern are shared by every algorithm
+			// the pattern always uses the thresholds, so the sides of the previous
+			// window must not be reused
+			if (fast) hqx_window = NULL;
+			int pattern = (patterns) ? getPattern(w, trY, trU, trV, trA) : 0;
+			if (fast) hqx_fastEdges(w);
+#ifdef HQX_STATS
+			++counter;
+#endif
+
+			for (uint32_t i = 0; i < count; ++i)
+			{
+#ifdef HQX_STATS
+				uint32_t sampling = scalers[i]->statsData->sampling;
+				uint64_t checks = hqx_checks;
+				bool sample = sampling > 0 && counter % sampling == 0;
+				uint64_t start = (sample) ? hqx_cycles() : 0;
+#endif
+				// the rows of the block are contiguous unless the output is rotated or mirrored
+				if (stepX[i] == 1)
+				{
+					scalers[i]->interpolate(pattern, w, output[i], (int) stepY[i], trY, trU, trV,
+						trA);
+				}
+				else
+				{
+					uint32_t f = factor[i];
+					scalers[i]->interpolate(pattern, w, block.data(), f, trY, trU, trV, trA);
+					hqx_store(block.data(), f, output[i], stepX[i], stepY[i]);
+				}
+#ifdef HQX_STATS
+				if (sample)
+				{
+					stats[i].cycles[pattern] += hqx_cycles() - start;
+					stats[i].samples[pattern]++;
+				}
+				stats[i].hits[pattern]++;
+				stats[i].checks[pattern] += hqx_checks - checks;
+#endif
+				output[i] += factor[i] * stepX[i];
+			}
+
+			image++;
+		}
+		image += stride - (lastCol - firstCol);
+
+		// filters the strips one output row at a time and stores them
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			if (filters[i] == NULL) continue;
+
+			uint32_t f = factor[i];
+			uint32_t *target = outputs[i] + (ptrdiff_t) ((row - firstRow) * f) * outputY[i];
+			for (uint32_t y = 0; y < f; ++y)
+			{
+				uint32_t *strip = strips[i].data() + (ptrdiff_t) y * stepY[i];
+				uint32_t *line = target + (ptrdiff_t) y * outputY[i];
+				filters[i]->apply(strip, (uint32_t) stepY[i], firstCol * f, row * f + y);
+				if (outputX[i] == 1)
+					memcpy(line, strip, (size_t) stepY[i] * sizeof(uint32_t));
+				else
+					for (ptrdiff_t x = 0; x < stepY[i]; ++x)
+						line[x * outputX[i]] = strip[x];
+			}
+		}
+	}
+
+	hqx_ayuv = ayuv;
+	hqx_window = window;
+	hqx_edges = edges;
+
+#ifdef HQX_STATS
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		HQxStatsData *data = scalers[i]->statsData;
+		std::lock_guard<std::mutex> guard(data->lock);
+		for (int j = 0; j < 256; ++j)
+		{
+			data->stats.hits[j]    += stats[i].hits[j];
+			data->stats.checks[j]  += stats[i].checks[j];
+			data->stats.cycles[j]  += stats[i].cycles[j];
+			data->stats.samples[j] += stats[i].samples[j];
+		}
+	}
+#endif
+}
+
+
+uint32_t *HQx::resizeParallel(
+	ThreadPool &pool,
+	const uint32_t *image,
+	uint32_t width,
+	uint32_t height,
+	uint32_t *output,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA,
+	bool wrapX,
+	bool wrapY ) const
+{
+	// uses a few bands per thread to compensate the uneven cost of the rows
+	uint32_t bands = pool.getSize() * 4;
+	if (bands > height) bands = height;
+	if (bands <= 1)
+		return resizeRows(image, width, height, output, 0, height, trY, trU, trV, trA, wrapX, wrapY);
+
+	pool.run(bands, [&](uint32_t band)
+	{
+		uint32_t firstRow = (uint32_t) ((uint64_t) height * band / bands);
+		uint32_t lastRow  = (uint32_t) ((uint64_t) height * (band + 1) / bands);
+		resizeRows(image, width, height, output, firstRow, lastRow, trY, trU, trV, trA, wrapX, wrapY);
+	});
+
+	return output + width * height * getFactor() * getFactor();
+}
+
+
+uint32_t *HQx::resizeInPlace(
+	uint32_t *buffer,
+	uint32_t width,
+	uint32_t height,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA,
+	bool wrapX,
+	bool wrapY ) const
+{
+	if (width == 0 || height == 0) return buffer;
+
+	const HQx *scaler = this;
+	uint32_t factor = getFactor();
+	size_t outputWidth = (size_t) width * factor;
+	const uint32_t *image = buffer + (size_t) width * height * (factor * factor - 1);
+
+	/*
+	 * The output of the source row 'y' ends at (y + 1) * factor^2 * width and
+	 * the source row 'y - 1' starts at (height * (factor^2 - 1) + y - 1) * width,
+	 * so every row except the last one can be written in place without
+	 * overwriting the rows of the next windows. The last row is resized first,
+	 * while every source row (including the first one, used with wrapY) is
+	 * still intact, and its output is moved to the buffer at the end.
+	 */
+	std::vector<uint32_t> last(outputWidth * factor);
+	uint32_t *output = last.data();
+	processRows(&scaler, 1, image, width, height, width, &output, 0, height - 1, height, 0, width,
+		trY, trU, trV, trA, wrapX, wrapY, false, colorSpace, alphaMode, quality, memoization);
+
+	output = buffer;
+	processRows(&scaler, 1, image, width, height, width, &output, 0, 0, height - 1, 0, width,
+		trY, trU, trV, trA, wrapX, wrapY, false, colorSpace, alphaMode, quality, memoization);
+
+	memcpy(buffer + (size_t) (height - 1) * factor * outputWidth, last.data(),
+		last.size() * sizeof(uint32_t));
+
+	return buffer + (size_t) width * height * factor * factor;
+}
+
+
+void HQx::resizeMultiple(
+	const HQx *const *scalers,
+	uint32_t count,
+	const uint32_t *image,
+	uint32_t width,
+	uint32_t height,
+	uint32_t *const *outputs,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA,
+	bool wrapX,
+	bool wrapY,
+	ThreadPool *pool )
+{
+	uint32_t bands = (pool != NULL) ? pool->getSize() * 4 : 1;
+	if (bands > height) bands = height;
+	if (bands < 1) bands = 1;
+
+	std::function<void(uint32_t)> task = [&](uint32_t band)
+	{
+		uint32_t firstRow = (uint32_t) ((uint64_t) height * band / bands);
+		uint32_t lastRow  = (uint32_t) ((uint64_t) height * (band + 1) / bands);
+		std::vector<uint32_t*> first(count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			uint32_t factor = scalers[i]->getFactor();
+			ptrdiff_t origin, stepX, stepY;
+			hqx_steps(scalers[i]->transform, width * factor, height * factor, 0, origin, stepX, stepY);
+			first[i] = outputs[i] + origin + (ptrdiff_t) (firstRow * factor) * stepY;
+		}
+		processRows(scalers, count, image, width, height, width, first.data(), 0, firstRow,
+			lastRow, 0, width, trY, trU, trV, trA, wrapX, wrapY, true, scalers[0]->colorSpace,
+			scalers[0]->alphaMode, scalers[0]->quality, scalers[0]->memoization);
+	};
+
+	if (bands == 1)
+		task(0);
+	else
+		pool->run(bands, task);
+}
+
+
+void HQx::resizeSprites(
+	const HQxSprite *sprites,
+	uint32_t count,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA,
+	bool wrapX,
+	bool wrapY,
+	ThreadPool *pool ) const
+{
+	// the sprites are small, so each task processes a group of them
+	uint32_t groups = (pool != NULL) ? pool->getSize() * 4 : 1;
+	if (groups > count) groups = count;
+	if (groups < 1) return;
+
+	const HQx *scaler = this;
+	uint32_t factor = getFactor();
+	std::function<void(uint32_t)> task = [&](uint32_t group)
+	{
+		uint32_t first = (uint32_t) ((uint64_t) count * group / groups);
+		uint32_t last  = (uint32_t) ((uint64_t) count * (group + 1) / groups);
+		for (uint32_t i = first; i < last; ++i)
+		{
+			const HQxSprite &sprite = sprites[i];
+			if (sprite.width == 0 || sprite.height == 0) continue;
+
+			ptrdiff_t origin, stepX, stepY;
+			hqx_steps(transform, sprite.width * factor, sprite.height * factor,
+				sprite.outputStride, origin, stepX, stepY);
+			uint32_t *output = sprite.output + origin;
+			processRows(&scaler, 1, sprite.image, sprite.width, sprite.height, sprite.stride,
+				&output, sprite.outputStride, 0, sprite.height, 0, sprite.width, trY, trU, trV, trA,
+				wrapX, wrapY, true, colorSpace, alphaMode, quality, memoization);
+		}
+	};
+
+	if (groups == 1)
+		task(0);
+	else
+		pool->run(groups, task);
+}
+
+
+void HQx::resizeAtlas(
+	const uint32_t *image,
+	uint32_t width,
+	uint32_t height,
+	uint32_t *output,
+	const HQxRect *rects,
+	uint32_t count,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA,
+	bool wrapX,
+	bool wrapY,
+	ThreadPool *pool ) const
+{
+	(void) height;
+
+	uint32_t factor = getFactor();
+	uint32_t outputWidth = width * factor;
+	std::vector<HQxSprite> sprites(count);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		const HQxRect &rect = rects[i];
+		sprites[i].image = image + (size_t) rect.y * width + rect.x;
+		sprites[i].width = rect.width;
+		sprites[i].height = rect.height;
+		sprites[i].stride = width;
+		sprites[i].output = output + (size_t) rect.y * factor * outputWidth + rect.x * factor;
+		sprites[i].outputStride = outputWidth;
+	}
+
+	resizeSprites(sprites.data(), count, trY, trU, trV, trA, wrapX, wrapY, pool);
+}
+
+
+/*
+ * Linear interpolation between two colors, with the weight of the second one
+ * given in 1/256 units.
+ */
+static inline uint32_t hqx_lerp(
+	uint32_t color1,
+	uint32_t color2,
+	uint32_t weight )
+{
+	if (weight == 0) return color1;
+
+	// red and blue in the first product, alpha and green in the second one
+	uint32_t rb = ((color1 & MASK_RB) * (256 - weight) + (color2 & MASK_RB) * weight) >> 8;
+	uint32_t ag = ((color1 >> 8) & MASK_RB) * (256 - weight) + ((color2 >> 8) & MASK_RB) * weight;
+	return (rb & MASK_RB) | (ag & ~MASK_RB);
+}
+
+
+/*
+ * Maps the center of the output pixel 'index' (of 'size') to the scaled image of
+ * 'scaledSize' pixels, returning the position in 1/256 units.
+ */
+static inline void hqx_map(
+	uint32_t index,
+	uint32_t size,
+	uint32_t scaledSize,
+	uint32_t &position,
+	uint32_t &weight )
+{
+	int64_t value = ((int64_t) (2 * index + 1) * scaledSize * 256) / (2 * size) - 128;
+	if (value < 0) value = 0;
+	position = (uint32_t) (value >> 8);
+	weight = (uint32_t) (value & 0xFF);
+	if (position >= scaledSize - 1)
+	{
+		position = scaledSize - 1;
+		weight = 0;
+	}
+}
+
+
+uint32_t *HQx::resizeTo(
+	const uint32_t *image,
+	uint32_t width,
+	uint32_t height,
+	uint32_t *output,
+	uint32_t outputWidth,
+	uint32_t outputHeight,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA,
+	bool wrapX,
+	bool wrapY,
+	ThreadPool *pool ) const
+{
+	// each band computes again the source rows it shares with its neighbors
+	uint32_t bands = (pool != NULL) ? pool->getSize() * 4 : 1;
+	if (bands > outputHeight) bands = outputHeight;
+	if (bands <= 1)
+	{
+		resampleRows(image, width, height, output, outputWidth, outputHeight, 0, outputHeight,
+			trY, trU, trV, trA, wrapX, wrapY);
+	}
+	else
+	{
+		pool->run(bands, [&](uint32_t band)
+		{
+			uint32_t firstRow = (uint32_t) ((uint64_t) outputHeight * band / bands);
+			uint32_t lastRow  = (uint32_t) ((uint64_t) outputHeight * (band + 1) / bands);
+			resampleRows(image, width, height, output, outputWidth, outputHeight, firstRow,
+				lastRow, trY, trU, trV, trA, wrapX, wrapY);
+		});
+	}
+
+	return output + outputWidth * outputHeight;
+}
+
+
+void HQx::resampleRows(
+	const uint32_t *image,
+	uint32_t width,
+	uint32_t height,
+	uint32_t *output,
+	uint32_t outputWidth,
+	uint32_t outputHeight,
+	uint32_t firstRow,
+	uint32_t lastRow,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA,
+	bool wrapX,
+	bool wrapY ) const
+{
+	const HQx *scaler = this;
+	uint32_t factor = getFactor();
+	uint32_t scaledWidth = width * factor;
+	uint32_t scaledHeight = height * factor;
+
+	// source column and weight of every output column
+	std::vector<uint32_t> columns(outputWidth), weights(outputWidth);
+	for (uint32_t x = 0; x < outputWidth; ++x)
+		hqx_map(x, outputWidth, scaledWidth, columns[x], weights[x]);
+
+	/*
+	 * The scaled output of two consecutive source rows is kept in a small buffer,
+	 * since every output row needs two consecutive scaled rows.
+	 */
+	std::vector<uint32_t> buffer(2 * factor * scaledWidth);
+	uint32_t cached[2] = { height, height };
+
+	ptrdiff_t origin, stepX, stepY;
+	hqx_steps(transform, outputWidth, outputHeight, 0, origin, stepX, stepY);
+	std::vector<uint32_t> filtered((filter != NULL) ? outputWidth : 0);
+
+	for (uint32_t y = firstRow; y < lastRow; ++y)
+	{
+		uint32_t position, weight;
+		hqx_map(y, outputHeight, scaledHeight, position, weight);
+
+		const uint32_t *lines[2];
+		for (int i = 0; i < 2; ++i)
+		{
+			uint32_t line = (i == 0 || weight == 0) ? position : position + 1;
+			uint32_t row = line / factor;
+			uint32_t *slot = buffer.data() + (row & 1) * factor * scaledWidth;
+			if (cached[row & 1] != row)
+			{
+				processRows(&scaler, 1, image, width, height, width, &slot, 0, row, row + 1, 0,
+					width, trY, trU, trV, trA, wrapX, wrapY, false, colorSpace, alphaMode, quality,
+					false);
+				cached[row & 1] = row;
+			}
+			lines[i] = slot + (line % factor) * scaledWidth;
+		}
+
+		// with a filter, the row is resampled in a temporary buffer
+		uint32_t *target = (filter != NULL) ? filtered.data() :
+			output + origin + (ptrdiff_t) y * stepY;
+		ptrdiff_t step = (filter != NULL) ? 1 : stepX;
+		for (uint32_t x = 0; x < outputWidth; ++x, target += step)
+		{
+			uint32_t column = columns[x];
+			uint32_t next = (weights[x] > 0) ? column + 1 : column;
+			uint32_t top = hqx_lerp(lines[0][column], lines[0][next], weights[x]);
+			uint32_t bottom = hqx_lerp(lines[1][column], lines[1][next], weights[x]);
+			*target = hqx_lerp(top, bottom, weight);
+		}
+
+		if (filter != NULL)
+		{
+			filter->apply(filtered.data(), outputWidth, 0, y);
+			target = output + origin + (ptrdiff_t) y * stepY;
+			for (uint32_t x = 0; x < outputWidth; ++x, target += stepX)
+				*target = filtered[x];
+		}
+	}
+}
+
+
+void HQx::resizeYUV(
+	const HQxYUVImage &image,
+	uint32_t width,
+	uint32_t height,
+	const HQxYUVImage &output,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA,
+	bool wrapX,
+	bool wrapY,
+	ThreadPool *pool ) const
+{
+	// the source is much smaller than the output, so it is packed once
+	std::vector<uint32_t> packed((size_t) width * height);
+	for (uint32_t y = 0; y < height; ++y)
+	{
+		const uint8_t *Y = image.planes[0] + (size_t) y * image.strides[0];
+		const uint8_t *U = image.planes[1] + (size_t) y * image.strides[1];
+		const uint8_t *V = image.planes[2] + (size_t) y * image.strides[2];
+		const uint8_t *A = image.planes[3];
+		if (A != NULL) A += (size_t) y * image.strides[3];
+		uint32_t *target = packed.data() + (size_t) y * width;
+		for (uint32_t x = 0; x < width; ++x)
+		{
+			target[x] = ((uint32_t) ((A != NULL) ? A[x] : 0xFF) << 24) | ((uint32_t) Y[x] << 16) |
+				((uint32_t) U[x] << 8) | V[x];
+		}
+	}
+
+	const HQx *scaler = this;
+	uint32_t factor = getFactor();
+	uint32_t outputWidth = width * factor;
+	uint32_t outputHeight = height * factor;
+	// the output rows are produced in pairs, which share the chroma in 4:2:0
+	uint32_t pairs = (outputHeight + 1) / 2;
+
+	uint32_t bands = (pool != NULL) ? pool->getSize() * 4 : 1;
+	if (bands > pairs) bands = pairs;
+	if (bands < 1) bands = 1;
+
+	std::function<void(uint32_t)> task = [&](uint32_t band)
+	{
+		uint32_t firstPair = (uint32_t) ((uint64_t) pairs * band / bands);
+		uint32_t lastPair  = (uint32_t) ((uint64_t) pairs * (band + 1) / bands);
+
+		// scaled output of two consecutive source rows
+		std::vector<uint32_t> buffer(2 * factor * outputWidth);
+		uint32_t cached[2] = { height, height };
+
+		for (uint32_t pair = firstPair; pair < lastPair; ++pair)
+		{
+			const uint32_t *lines[2];
+			uint32_t count = (2 * pair + 1 < outputHeight) ? 2 : 1;
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				uint32_t line = 2 * pair + i;
+				uint32_t row = line / factor;
+				uint32_t *slot = buffer.data() + (row & 1) * factor * outputWidth;
+				if (cached[row & 1] != row)
+				{
+					processRows(&scaler, 1, packed.data(), width, height, width, &slot, 0, row,
+						row + 1, 0, width, trY, trU, trV, trA, wrapX, wrapY, false, HQX_AYUV,
+						HQX_ALPHA_STRAIGHT, quality, false);
+					cached[row & 1] = row;
+				}
+				lines[i] = slot + (line % factor) * outputWidth;
+			}
+			if (count == 1) lines[1] = lines[0];
+
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				size_t y = 2 * pair + i;
+				uint8_t *Y = output.planes[0] + y * output.strides[0];
+				uint8_t *A = output.planes[3];
+				if (A != NULL) A += y * output.strides[3];
+				for (uint32_t x = 0; x < outputWidth; ++x)
+					Y[x] = (uint8_t) (lines[i][x] >> 16);
+				if (A != NULL)
+				{
+					for (uint32_t x = 0; x < outputWidth; ++x)
+						A[x] = (uint8_t) (lines[i][x] >> 24);
+				}
+				if (output.subsampled || output.planes[1] == NULL) continue;
+
+				uint8_t *U = output.planes[1] + y * output.strides[1];
+				uint8_t *V = output.planes[2] + y * output.strides[2];
+				for (uint32_t x = 0; x < outputWidth; ++x)
+				{
+					U[x] = (uint8_t) (lines[i][x] >> 8);
+					V[x] = (uint8_t) lines[i][x];
+				}
+			}
+
+			if (output.subsampled && output.planes[1] != NULL)
+			{
+				uint8_t *U = output.planes[1] + (size_t) pair * output.strides[1];
+				uint8_t *V = output.planes[2] + (size_t) pair * output.strides[2];
+				for (uint32_t x = 0; x < outputWidth; x += 2)
+				{
+					uint32_t next = (x + 1 < outputWidth) ? x + 1 : x;
+					uint32_t c0 = lines[0][x], c1 = lines[0][next];
+					uint32_t c2 = lines[1][x], c3 = lines[1][next];
+					U[x / 2] = (uint8_t) ((((c0 >> 8) & 0xFF) + ((c1 >> 8) & 0xFF) +
+						((c2 >> 8) & 0xFF) + ((c3 >> 8) & 0xFF) + 2) / 4);
+					V[x / 2] = (uint8_t) (((c0 & 0xFF) + (c1 & 0xFF) + (c2 & 0xFF) + (c3 & 0xFF) +
+						2) / 4);
+				}
+			}
+		}
+	};
+
+	if (bands == 1)
+		task(0);
+	else
+		pool->run(bands, task);
+}
+
+
+/*
+ * Computes the pattern and the comparisons between the sides of the window
+ * (see HQx::getEdges) of every pixel of a single-channel row, and whether every
+ * pixel of the window is equal to the central one. The rows above, at and below
+ * the current one have a border column at each side.
+ */
+static void hqx_grayCompare(
+	const uint8_t *above,
+	const uint8_t *line,
+	const uint8_t *below,
+	uint32_t width,
+	uint32_t trY,
+	bool fast,
+	uint8_t *patterns,
+	uint8_t *edges,
+	uint8_t *uniform )
+{
+	// the sides are compared for equality with HQX_QUALITY_FAST
+	int threshold = (int) std::min(trY, 255U);
+	int sideThreshold = (fast) ? 0 : threshold;
+	uint32_t x = 0;
+
+#ifdef HQX_SSE2
+	// sixteen pixels at a time; a value differs if |a - b| - threshold > 0
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i limit = _mm_set1_epi8((char) threshold);
+	const __m128i sideLimit = _mm_set1_epi8((char) sideThreshold);
+	for (; x + 16 <= width; x += 16)
+	{
+		__m128i w[9];
+		for (int i = 0; i < 3; ++i)
+		{
+			w[i]     = _mm_loadu_si128((const __m128i*) (above + x + i));
+			w[i + 3] = _mm_loadu_si128((const __m128i*) (line + x + i));
+			w[i + 6] = _mm_loadu_si128((const __m128i*) (below + x + i));
+		}
+
+		__m128i pattern = zero;
+		__m128i equal = _mm_set1_epi8(1);
+		for (int k = 0, flag = 1; k < 9; ++k)
+		{
+			if (k == 4) continue;
+			__m128i diff = _mm_or_si128(_mm_subs_epu8(w[k], w[4]), _mm_subs_epu8(w[4], w[k]));
+			__m128i same = _mm_cmpeq_epi8(_mm_subs_epu8(diff, limit), zero);
+			pattern = _mm_or_si128(pattern, _mm_andnot_si128(same, _mm_set1_epi8((char) flag)));
+			equal = _mm_and_si128(equal, _mm_cmpeq_epi8(diff, zero));
+			flag <<= 1;
+		}
+
+		__m128i sides = zero;
+		for (int i = 0; i < 4; ++i)
+		{
+			__m128i side1 = w[ HQX_SIDES[i][0] ], side2 = w[ HQX_SIDES[i][1] ];
+			__m128i diff = _mm_or_si128(_mm_subs_epu8(side1, side2), _mm_subs_epu8(side2, side1));
+			__m128i same = _mm_cmpeq_epi8(_mm_subs_epu8(diff, sideLimit), zero);
+			sides = _mm_or_si128(sides, _mm_andnot_si128(same, _mm_set1_epi8((char) (1 << i))));
+		}
+
+		_mm_storeu_si128((__m128i*) (patterns + x), pattern);
+		_mm_storeu_si128((__m128i*) (edges + x), sides);
+		_mm_storeu_si128((__m128i*) (uniform + x), equal);
+	}
+#endif
+
+	for (; x < width; ++x)
+	{
+		const uint8_t w[9] = { above[x], above[x + 1], above[x + 2], line[x], line[x + 1],
+			line[x + 2], below[x], below[x + 1], below[x + 2] };
+
+		int pattern = 0;
+		bool equal = true;
+		for (int k = 0, flag = 1; k < 9; ++k)
+		{
+			if (k == 4) continue;
+			if (abs(w[k] - w[4]) > threshold) pattern |= flag;
+			equal &= (w[k] == w[4]);
+			flag <<= 1;
+		}
+		int sides = 0;
+		for (int i = 0; i < 4; ++i)
+			if (abs(w[ HQX_SIDES[i][0] ] - w[ HQX_SIDES[i][1] ]) > sideThreshold) sides |= 1 << i;
+
+		patterns[x] = (uint8_t) pattern;
+		edges[x] = (uint8_t) sides;
+		uniform[x] = equal;
+	}
+}
+
+
+/*
+ * Scales the rows [firstRow, lastRow) of a single-channel image with the blends
+ * of a scaler.
+ */
+static void hqx_grayRows(
+	const HQxGrayRules &rules,
+	const uint8_t *image,
+	uint32_t width,
+	uint32_t height,
+	uint8_t *output,
+	uint32_t firstRow,
+	uint32_t lastRow,
+	uint32_t trY,
+	bool wrapX,
+	bool wrapY,
+	bool fast )
+{
+	uint32_t factor = rules.factor;
+	size_t outputWidth = (size_t) width * factor;
+	size_t blockTerms = (size_t) factor * factor * HQX_GRAY_TERMS * 2;
+
+	// the rows around the current one, with a border column at each side
+	uint32_t padded = width + 2;
+	std::vector<uint8_t> rows(3 * padded);
+	std::vector<uint8_t> patterns(width), edges(width), uniform(width);
+
+	for (uint32_t row = firstRow; row < lastRow; ++row)
+	{
+		const uint8_t *sources[3];
+		sources[1] = image + (size_t) row * width;
+		sources[0] = sources[2] = sources[1];
+		if (row > 0)
+			sources[0] = sources[1] - width;
+		else
+		if (wrapY)
+			sources[0] = image + (size_t) (height - 1) * width;
+		if (row < height - 1)
+			sources[2] = sources[1] + width;
+		else
+		if (wrapY)
+			sources[2] = image;
+
+		for (int i = 0; i < 3; ++i)
+		{
+			uint8_t *target = rows.data() + i * padded;
+			memcpy(target + 1, sources[i], width);
+			target[0] = sources[i][(wrapX) ? width - 1 : 0];
+			target[width + 1] = sources[i][(wrapX) ? 0 : width - 1];
+		}
+		const uint8_t *above = rows.data();
+		const uint8_t *line = above + padded;
+		const uint8_t *below = line + padded;
+		hqx_grayCompare(above, line, below, width, trY, fast, patterns.data(), edges.data(),
+			uniform.data());
+
+		uint8_t *block = output + (size_t) row * factor * outputWidth;
+		for (uint32_t x = 0; x < width; ++x, block += factor)
+		{
+			// every blend of a uniform window is the central pixel
+			if (uniform[x])
+			{
+				for (uint32_t y = 0; y < factor; ++y)
+					memset(block + y * outputWidth, line[x + 1], factor);
+				continue;
+			}
+
+			const uint8_t w[9] = { above[x], above[x + 1], above[x + 2], line[x], line[x + 1],
+				line[x + 2], below[x], below[x + 1], below[x + 2] };
+			const uint8_t *terms = rules.terms.data() +
+				((size_t) patterns[x] * 16 + edges[x]) * blockTerms;
+			for (uint32_t y = 0; y < factor; ++y)
+			{
+				uint8_t *target = block + y * outputWidth;
+				for (uint32_t i = 0; i < factor; ++i, terms += HQX_GRAY_TERMS * 2)
+					target[i] = (uint8_t) ((w[ terms[0] ] * terms[1] + w[ terms[2] ] * terms[3] +
+						w[ terms[4] ] * terms[5]) >> 4);
+			}
+		}
+	}
+}
+
+
+const HQxGrayRules &HQx::getGrayRules() const
+{
+	static std::mutex lock;
+	std::lock_guard<std::mutex> guard(lock);
+	if (grayRules != NULL) return *grayRules;
+
+	uint32_t factor = getFactor();
+	uint32_t pixels = factor * factor;
+	HQxGrayRules *rules = new HQxGrayRules();
+	rules->factor = factor;
+	rules->terms.assign((size_t) 256 * 16 * pixels * HQX_GRAY_TERMS * 2, 0);
+
+	/*
+	 * The weights are found by interpolating windows where one component of three
+	 * pixels is 255 and the others are 0, so each component of the output is 255
+	 * times the weight of one pixel. The alpha makes every pixel of the window
+	 * different, so the comparisons between the sides can be replaced.
+	 */
+	const uint32_t *window = hqx_window;
+	int windowEdges = hqx_edges;
+	uint32_t w[9];
+	std::vector<uint32_t> block(pixels);
+	std::vector<uint8_t> weights(pixels * 9);
+	for (int pattern = 0; pattern < 256; ++pattern)
+		for (int edges = 0; edges < 16; ++edges)
+		{
+			for (int group = 0; group < 3; ++group)
+			{
+				for (int k = 0; k < 9; ++k)
+				{
+					w[k] = (uint32_t) (k + 1) << 24;
+					if (k / 3 == group) w[k] |= 0xFFU << (16 - 8 * (k % 3));
+				}
+				setEdges(w, edges);
+				interpolate(pattern, w, block.data(), (int) factor, 0, 0, 0, 0);
+
+				for (uint32_t j = 0; j < pixels; ++j)
+					for (int c = 0; c < 3; ++c)
+					{
+						uint32_t value = (block[j] >> (16 - 8 * c)) & 0xFF;
+						uint32_t weight = 0;
+						while (weight < 16 && 255 * weight / 16 != value) ++weight;
+						weights[j * 9 + group * 3 + c] = (uint8_t) weight;
+					}
+			}
+
+			uint8_t *terms = rules->terms.data() + ((size_t) pattern * 16 + edges) * pixels *
+				HQX_GRAY_TERMS * 2;
+			for (uint32_t j = 0; j < pixels; ++j, terms += HQX_GRAY_TERMS * 2)
+			{
+				uint32_t count = 0;
+				for (int k = 0; k < 9 && count < HQX_GRAY_TERMS; ++k)
+				{
+					if (weights[j * 9 + k] == 0) continue;
+					terms[count * 2] = (uint8_t) k;
+					terms[count * 2 + 1] = weights[j * 9 + k];
+					++count;
+				}
+			}
+		}
+	hqx_window = window;
+	hqx_edges = windowEdges;
+
+	grayRules = rules;
+	return *grayRules;
+}
+
+
+void HQx::resizeGray(
+	const uint8_t *image,
+	uint32_t width,
+	uint32_t height,
+	uint8_t *output,
+	uint32_t trY,
+	bool wrapX,
+	bool wrapY,
+	ThreadPool *pool ) const
+{
+	if (!usesPattern())
+	{
+		// neutral chroma, shared by every row of the input
+		std::vector<uint8_t> chroma(width, 0x80);
+
+		HQxYUVImage input = { { (uint8_t*) image, chroma.data(), chroma.data(), NULL },
+			{ width, 0, 0, 0 }, false };
+		HQxYUVImage luma = { { output, NULL, NULL, NULL }, { width * getFactor(), 0, 0, 0 },
+			false };
+		resizeYUV(input, width, height, luma, trY, 0, 0, 0, wrapX, wrapY, pool);
+		return;
+	}
+
+	const HQxGrayRules &rules = getGrayRules();
+	bool fast = (quality == HQX_QUALITY_FAST);
+
+	uint32_t bands = (pool != NULL) ? pool->getSize() * 4 : 1;
+	if (bands > height) bands = height;
+	if (bands < 1) bands = 1;
+
+	std::function<void(uint32_t)> task = [&](uint32_t band)
+	{
+		uint32_t firstRow = (uint32_t) ((uint64_t) height * band / bands);
+		uint32_t lastRow  = (uint32_t) ((uint64_t) height * (band + 1) / bands);
+		hqx_grayRows(rules, image, width, height, output, firstRow, lastRow, trY, wrapX, wrapY,
+			fast);
+	};
+
+	if (bands == 1)
+		task(0);
+	else
+		pool->run(bands, task);
+}
+
+
+bool HQx::usesPattern() const
+{
+	return true;
+}
+
 
 /*
  * Use this function for sharper images (good for cartoon style, used by DOSBOX)
  */
 
-bool HQx::isDifferent(
+bool HQx::isDifferentSharp(
 	uint32_t color1,
 	uint32_t color2,
 	uint32_t trY,
@@ -86,13 +1497,12 @@ bool HQx::isDifferent(
 	return false;
 }
 
-#else
 
 /*
  * Use this function for smoothed images (good for complex graphics)
  */
 
-bool HQx::isDifferent(
+bool HQx::isDifferentSmooth(
 	uint32_t color1,
 	uint32_t color2,
 	uint32_t trY,
@@ -109,4 +1519,268 @@ bool HQx::isDifferent(
 		   abs(int(yuv1 & AMASK) - int(yuv2 & AMASK)) > trA;
 }
 
+
+bool HQx::isDifferent(
+	uint32_t color1,
+	uint32_t color2,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA )
+{
+#ifdef HQX_STATS
+	++hqx_checks;
+#endif
+
+	if (hqx_window != NULL)
+	{
+		// the comparisons depend only on the colors, so any pair with the same
+		// colors as a side of the window has the same result
+		for (int i = 0; i < 4; ++i)
+		{
+			uint32_t side1 = hqx_window[ HQX_SIDES[i][0] ];
+			uint32_t side2 = hqx_window[ HQX_SIDES[i][1] ];
+			if ((color1 == side1 && color2 == side2) || (color1 == side2 && color2 == side1))
+				return (hqx_edges & (1 << i)) != 0;
+		}
+	}
+
+	if (hqx_ayuv)
+	{
+		return abs(int(color1 & YMASK) - int(color2 & YMASK)) > trY ||
+			   abs(int(color1 & UMASK) - int(color2 & UMASK)) > trU ||
+			   abs(int(color1 & VMASK) - int(color2 & VMASK)) > trV ||
+			   abs(int(color1 & AMASK) - int(color2 & AMASK)) > trA;
+	}
+
+	// change to zero to use the smoothed version
+#if (1)
+	return isDifferentSharp(color1, color2, trY, trU, trV, trA);
+#else
+	return isDifferentSmooth(color1, color2, trY, trU, trV, trA);
 #endif
+}
+
+
+int HQx::getPattern(
+	const uint32_t *w,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA )
+{
+	int pattern = 0;
+
+	// computes the pattern to be used considering the neighbor pixels
+	for (int k = 0, flag = 1; k < 9; k++)
+	{
+		// ignores the central pixel
+		if (k == 4) continue;
+
+		if (w[k] != w[4])
+			if (isDifferent(w[4], w[k], trY, trU, trV, trA)) pattern |= flag;
+		flag <<= 1;
+	}
+
+	return pattern;
+}
+
+
+int HQx::getEdges(
+	const uint32_t *w,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA )
+{
+	int edges = 0;
+
+	for (int i = 0; i < 4; ++i)
+	{
+		uint32_t side1 = w[ HQX_SIDES[i][0] ];
+		uint32_t side2 = w[ HQX_SIDES[i][1] ];
+		if (side1 != side2 && isDifferent(side1, side2, trY, trU, trV, trA))
+			edges |= 1 << i;
+	}
+
+	return edges;
+}
+
+
+HQxColorSpace HQx::swapColorSpace(
+	HQxColorSpace colorSpace )
+{
+	HQxColorSpace previous = (hqx_ayuv) ? HQX_AYUV : HQX_ARGB;
+	hqx_ayuv = (colorSpace == HQX_AYUV);
+	return previous;
+}
+
+
+void HQx::setEdges(
+	const uint32_t *w,
+	int edges )
+{
+	hqx_window = w;
+	hqx_edges = edges;
+}
+
+
+bool HQx::hasStats()
+{
+#ifdef HQX_STATS
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+bool HQx::getStats(
+	HQxStats &stats ) const
+{
+	memset(&stats, 0, sizeof(stats));
+#ifdef HQX_STATS
+	std::lock_guard<std::mutex> guard(statsData->lock);
+	stats = statsData->stats;
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+void HQx::resetStats()
+{
+#ifdef HQX_STATS
+	std::lock_guard<std::mutex> guard(statsData->lock);
+	memset(&statsData->stats, 0, sizeof(HQxStats));
+#endif
+}
+
+
+void HQx::setStatsSampling(
+	uint32_t period )
+{
+#ifdef HQX_STATS
+	statsData->sampling = period;
+#else
+	(void) period;
+#endif
+}
+
+
+void HQx::setTransform(
+	HQxTransform transform )
+{
+	this->transform = transform;
+}
+
+
+HQxTransform HQx::getTransform() const
+{
+	return transform;
+}
+
+
+void HQx::setFilter(
+	const HQxFilter *filter )
+{
+	this->filter = filter;
+}
+
+
+const HQxFilter *HQx::getFilter() const
+{
+	return filter;
+}
+
+
+void HQx::setColorSpace(
+	HQxColorSpace colorSpace )
+{
+	this->colorSpace = colorSpace;
+}
+
+
+HQxColorSpace HQx::getColorSpace() const
+{
+	return colorSpace;
+}
+
+
+void HQx::setAlphaMode(
+	HQxAlphaMode alphaMode )
+{
+	this->alphaMode = alphaMode;
+}
+
+
+HQxAlphaMode HQx::getAlphaMode() const
+{
+	return alphaMode;
+}
+
+
+void HQx::premultiply(
+	uint32_t *pixels,
+	size_t count )
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		uint32_t A = pixels[i] >> 24;
+		// rounded division by 255 of the 16-bit products
+		uint32_t rb = (pixels[i] & 0x00FF00FF) * A + 0x00800080;
+		uint32_t g  = (pixels[i] & 0x0000FF00) * A + 0x00008000;
+		rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+		g  = ((g + ((g >> 8) & 0x0000FF00)) >> 8) & 0x0000FF00;
+		pixels[i] = (A << 24) | rb | g;
+	}
+}
+
+
+void HQx::unpremultiply(
+	uint32_t *pixels,
+	size_t count )
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		uint32_t A = pixels[i] >> 24;
+		if (A == 0 || A == 255) continue;
+		uint32_t R = ((pixels[i] >> 16) & 0xFF) * 255 + A / 2;
+		uint32_t G = ((pixels[i] >> 8) & 0xFF) * 255 + A / 2;
+		uint32_t B = (pixels[i] & 0xFF) * 255 + A / 2;
+		R /= A;
+		G /= A;
+		B /= A;
+		if (R > 255) R = 255;
+		if (G > 255) G = 255;
+		if (B > 255) B = 255;
+		pixels[i] = (A << 24) | (R << 16) | (G << 8) | B;
+	}
+}
+
+
+void HQx::setMemoization(
+	bool enabled )
+{
+	memoization = enabled;
+}
+
+
+bool HQx::getMemoization() const
+{
+	return memoization;
+}
+
+
+void HQx::setQuality(
+	HQxQuality quality )
+{
+	this->quality = quality;
+}
+
+
+HQxQuality HQx::getQuality() const
+{
+	return quality;
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hqx/HQxFilter.hh>
+#include <cmath>
+
+
+enum
+{
+	OP_SCANLINES,
+	OP_MATRIX,
+	OP_GAMMA
+};
+
+
+static inline uint32_t hqx_clamp(
+	int32_t value )
+{
+	return (value < 0) ? 0 : (value > 255) ? 255 : (uint32_t) value;
+}
+
+
+HQxFilter::~HQxFilter()
+{
+	// nothing to do
+}
+
+
+HQxPostProcess::HQxPostProcess()
+{
+	// nothing to do
+}
+
+
+HQxPostProcess::~HQxPostProcess()
+{
+	// nothing to do
+}
+
+
+void HQxPostProcess::addScanlines(
+	float intensity,
+	uint32_t period,
+	uint32_t lines )
+{
+	if (period == 0 || lines == 0) return;
+	if (intensity < 0) intensity = 0;
+	if (intensity > 1) intensity = 1;
+
+	Operation op;
+	op.type = OP_SCANLINES;
+	op.period = period;
+	op.lines = (lines > period) ? period : lines;
+	op.values[0] = (int32_t) ((1.0f - intensity) * 256.0f + 0.5f);
+	operations.push_back(op);
+}
+
+
+void HQxPostProcess::addColorMatrix(
+	const float *matrix )
+{
+	Operation op;
+	op.type = OP_MATRIX;
+	for (int i = 0; i < 12; ++i)
+	{
+		// the offsets are given in the [0, 255] range like the components
+		float value = matrix[i] * 4096.0f;
+		op.values[i] = (int32_t) ((value < 0) ? value - 0.5f : value + 0.5f);
+	}
+	operations.push_back(op);
+}
+
+
+void HQxPostProcess::addGamma(
+	float gamma )
+{
+	Operation op;
+	op.type = OP_GAMMA;
+	for (int i = 0; i < 256; ++i)
+		op.table[i] = (uint8_t) hqx_clamp((int32_t) (255.0 * pow(i / 255.0, (double) gamma) + 0.5));
+	operations.push_back(op);
+}
+
+
+void HQxPostProcess::clear()
+{
+	operations.clear();
+}
+
+
+void HQxPostProcess::apply(
+	uint32_t *pixels,
+	uint32_t count,
+	uint32_t x,
+	uint32_t y ) const
+{
+	(void) x;
+
+	for (size_t k = 0; k < operations.size(); ++k)
+	{
+		const Operation &op = operations[k];
+
+		if (op.type == OP_SCANLINES)
+		{
+			if (y % op.period < op.period - op.lines) continue;
+
+			uint32_t scale = (uint32_t) op.values[0];
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				uint32_t value = pixels[i];
+				uint32_t rb = (((value & 0x00FF00FF) * scale) >> 8) & 0x00FF00FF;
+				uint32_t g  = (((value & 0x0000FF00) * scale) >> 8) & 0x0000FF00;
+				pixels[i] = (value & 0xFF000000) | rb | g;
+			}
+		}
+		else
+		if (op.type == OP_MATRIX)
+		{
+			const int32_t *m = op.values;
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				uint32_t value = pixels[i];
+				int32_t r = (value >> 16) & 0xFF;
+				int32_t g = (value >> 8) & 0xFF;
+				int32_t b = value & 0xFF;
+				uint32_t nr = hqx_clamp((m[0] * r + m[1] * g + m[2]  * b + m[3]  + 2048) >> 12);
+				uint32_t ng = hqx_clamp((m[4] * r + m[5] * g + m[6]  * b + m[7]  + 2048) >> 12);
+				uint32_t nb = hqx_clamp((m[8] * r + m[9] * g + m[10] * b + m[11] + 2048) >> 12);
+				pixels[i] = (value & 0xFF000000) | (nr << 16) | (ng << 8) | nb;
+			}
+		}
+		else
+		{
+			const uint8_t *table = op.table;
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				uint32_t value = pixels[i];
+				pixels[i] = (value & 0xFF000000) |
+					((uint32_t) table[(value >> 16) & 0xFF] << 16) |
+					((uint32_t) table[(value >> 8) & 0xFF] << 8) |
+					table[value & 0xFF];
+			}
+		}
+	}
+}
@@ -0,0 +1,218 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hqx/HQxGovernor.hh>
+#include <hqx/ThreadPool.hh>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+
+
+// the pixels equal to their neighbors still cost about a quarter of the others
+static const double HQX_EQUAL_COST = 0.25;
+
+// weight of the last frame in the measured cost
+static const double HQX_COST_WEIGHT = 0.3;
+
+// consecutive frames with the fast quality before one with the full quality
+static const uint32_t HQX_PROBE_FRAMES = 32;
+
+
+HQxGovernor::HQxGovernor(
+	HQx &scaler,
+	double budget,
+	ThreadPool *pool ) : scaler(scaler), budget(budget), pool(pool), frames(0),
+		degradedFrames(0), fastFrames(0), ratio(0)
+{
+	memset(&report, 0, sizeof(report));
+	cost[HQX_QUALITY_FULL] = cost[HQX_QUALITY_FAST] = 0;
+}
+
+
+HQxGovernor::~HQxGovernor()
+{
+	// nothing to do
+}
+
+
+double HQxGovernor::getEqualRatio(
+	const uint32_t *image,
+	uint32_t width,
+	uint32_t height )
+{
+	if (width < 2 || height < 2) return 1.0;
+
+	// one in every four rows is enough to follow the content of the frames
+	uint64_t equal = 0, total = 0;
+	for (uint32_t y = 0; y < height - 1; y += 4)
+	{
+		const uint32_t *row = image + (size_t) y * width;
+		const uint32_t *below = row + width;
+		for (uint32_t x = 0; x < width - 1; ++x)
+			equal += (uint64_t) (row[x] == row[x + 1]) + (uint64_t) (row[x] == below[x]);
+		total += 2 * (width - 1);
+	}
+
+	return (double) equal / (double) total;
+}
+
+
+const HQxFrameReport &HQxGovernor::resize(
+	const uint32_t *image,
+	uint32_t width,
+	uint32_t height,
+	uint32_t *output,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA,
+	bool wrapX,
+	bool wrapY )
+{
+	typedef std::chrono::steady_clock Clock;
+	Clock::time_point start = Clock::now();
+
+	// the quality of the previous frame, whose cost is still recent
+	HQxQuality previous = report.quality;
+	bool first = frames == 0;
+	report.frame = frames++;
+	report.equalRatio = getEqualRatio(image, width, height);
+	double work = (double) width * height * (HQX_EQUAL_COST + 1.0 - report.equalRatio);
+	report.predicted = cost[HQX_QUALITY_FULL] * work;
+
+	// frames predicted over the budget use the fast quality and smaller bands,
+	// so the deadline is checked more often; after many of them one frame uses
+	// the full quality to measure its cost again
+	bool over = report.predicted > budget && fastFrames < HQX_PROBE_FRAMES;
+	HQxQuality quality = (over) ? HQX_QUALITY_FAST : HQX_QUALITY_FULL;
+	double expected = ((cost[quality] > 0) ? cost[quality] : cost[HQX_QUALITY_FULL]) * work;
+
+	uint32_t threads = (pool != NULL) ? pool->getSize() : 1;
+	uint32_t bands = threads * ((over) ? 16 : 4);
+	if (bands > height) bands = height;
+	if (bands < 1) bands = 1;
+	// time taken by one band in one thread
+	double bandTime = expected * threads / bands;
+
+	// the nearest-neighbor bands would not match a transformed or filtered output
+	bool nearest = scaler.getTransform() == HQX_IDENTITY && scaler.getFilter() == NULL;
+	uint32_t factor = scaler.getFactor();
+	size_t outputWidth = (size_t) width * factor;
+	std::atomic<uint32_t> nearestBands(0);
+	// time spent by the bands resized with the scaler and their rows, which give
+	// the cost even when the other bands are replaced by nearest-neighbor
+	std::atomic<uint64_t> scaledTime(0);
+	std::atomic<uint32_t> scaledRows(0);
+
+	std::function<void(uint32_t)> task = [&](uint32_t band)
+	{
+		uint32_t firstRow = (uint32_t) ((uint64_t) height * band / bands);
+		uint32_t lastRow  = (uint32_t) ((uint64_t) height * (band + 1) / bands);
+
+		double now = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		if (nearest && now + bandTime > budget)
+		{
+			for (uint32_t y = firstRow; y < lastRow; ++y)
+			{
+				const uint32_t *source = image + (size_t) y * width;
+				uint32_t *target = output + (size_t) y * factor * outputWidth;
+				for (uint32_t x = 0; x < width; ++x)
+					std::fill_n(target + (size_t) x * factor, factor, source[x]);
+				for (uint32_t i = 1; i < factor; ++i)
+					memcpy(target + i * outputWidth, target, outputWidth * sizeof(uint32_t));
+			}
+			++nearestBands;
+			return;
+		}
+
+		Clock::time_point begin = Clock::now();
+		// the quality is not set in the scaler, which other threads may be using
+		scaler.resizeRows(image, width, height, output, firstRow, lastRow, trY, trU, trV, trA,
+			wrapX, wrapY, quality);
+		scaledTime += (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+			Clock::now() - begin).count();
+		scaledRows += lastRow - firstRow;
+	};
+
+	if (pool != NULL && bands > 1)
+		pool->run(bands, task);
+	else
+		for (uint32_t band = 0; band < bands; ++band) task(band);
+
+	report.elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	report.quality = quality;
+	report.bands = bands;
+	report.nearestBands = nearestBands;
+	report.degraded = quality != HQX_QUALITY_FULL || report.nearestBands > 0;
+	if (report.degraded) ++degradedFrames;
+
+	// the cost is the time of the frame per unit of work, so the time of the
+	// bands is divided by the threads which were running them
+	if (scaledRows > 0 && work > 0)
+	{
+		double threadTime = (double) scaledTime / 1e6 / std::min(threads, bands);
+		double sample = threadTime / (work * scaledRows / height);
+		cost[quality] = (cost[quality] > 0) ?
+			cost[quality] * (1 - HQX_COST_WEIGHT) + sample * HQX_COST_WEIGHT : sample;
+
+		// the ratio between the costs is measured when the quality changes, while
+		// both are recent, and then gives the cost of the quality not being used
+		if (!first && quality != previous && cost[HQX_QUALITY_FAST] > 0 &&
+			cost[HQX_QUALITY_FULL] > 0)
+			ratio = cost[HQX_QUALITY_FULL] / cost[HQX_QUALITY_FAST];
+		if (ratio > 0 && quality == HQX_QUALITY_FAST)
+			cost[HQX_QUALITY_FULL] = cost[HQX_QUALITY_FAST] * ratio;
+		else
+		if (ratio > 0)
+			cost[HQX_QUALITY_FAST] = cost[HQX_QUALITY_FULL] / ratio;
+	}
+	fastFrames = (quality == HQX_QUALITY_FAST) ? fastFrames + 1 : 0;
+
+	return report;
+}
+
+
+void HQxGovernor::setBudget(
+	double budget )
+{
+	this->budget = budget;
+}
+
+
+double HQxGovernor::getBudget() const
+{
+	return budget;
+}
+
+
+const HQxFrameReport &HQxGovernor::getReport() const
+{
+	return report;
+}
+
+
+uint64_t HQxGovernor::getFrames() const
+{
+	return frames;
+}
+
+
+uint64_t HQxGovernor::getDegradedFrames() const
+{
+	return degradedFrames;
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hqx/HQxMap.hh>
+#include <hqx/ThreadPool.hh>
+#include <functional>
+
+
+HQxMap::HQxMap() : image(NULL), width(0), height(0), trY(0), trU(0), trV(0), trA(0),
+	wrapX(false), wrapY(false), colorSpace(HQX_ARGB)
+{
+	// nothing to do
+}
+
+
+HQxMap::~HQxMap()
+{
+	// nothing to do
+}
+
+
+void HQxMap::getWindow(
+	uint32_t x,
+	uint32_t y,
+	uint32_t *w ) const
+{
+	const uint32_t *row = image + (size_t) y * width;
+	const uint32_t *last = image + (size_t) (height - 1) * width;
+	const uint32_t *above = (y > 0) ? row - width : (wrapY ? last : row);
+	const uint32_t *below = (y < height - 1) ? row + width : (wrapY ? image : row);
+	uint32_t left = (x > 0) ? x - 1 : (wrapX ? width - 1 : x);
+	uint32_t right = (x < width - 1) ? x + 1 : (wrapX ? 0 : x);
+
+	w[0] = above[left];
+	w[1] = above[x];
+	w[2] = above[right];
+	w[3] = row[left];
+	w[4] = row[x];
+	w[5] = row[right];
+	w[6] = below[left];
+	w[7] = below[x];
+	w[8] = below[right];
+}
+
+
+void HQxMap::build(
+	const uint32_t *image,
+	uint32_t width,
+	uint32_t height,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA,
+	bool wrapX,
+	bool wrapY,
+	ThreadPool *pool )
+{
+	this->image = image;
+	this->width = width;
+	this->height = height;
+	this->trY = trY << 16;
+	this->trU = trU << 8;
+	this->trV = trV;
+	this->trA = trA << 24;
+	this->wrapX = wrapX;
+	this->wrapY = wrapY;
+	map.resize((size_t) width * height);
+
+	uint32_t bands = (pool != NULL) ? pool->getSize() * 4 : 1;
+	if (bands > height) bands = height;
+	if (bands < 1) return;
+
+	std::function<void(uint32_t)> task = [&](uint32_t band)
+	{
+		uint32_t firstRow = (uint32_t) ((uint64_t) height * band / bands);
+		uint32_t lastRow  = (uint32_t) ((uint64_t) height * (band + 1) / bands);
+		HQxColorSpace previous = HQx::swapColorSpace(colorSpace);
+		for (uint32_t y = firstRow; y < lastRow; ++y)
+		{
+			uint16_t *target = map.data() + (size_t) y * width;
+			for (uint32_t x = 0; x < width; ++x)
+			{
+				uint32_t w[9];
+				getWindow(x, y, w);
+				int pattern = HQx::getPattern(w, this->trY, this->trU, this->trV, this->trA);
+				int edges = HQx::getEdges(w, this->trY, this->trU, this->trV, this->trA);
+				target[x] = (uint16_t) (pattern | (edges << 8));
+			}
+		}
+		HQx::swapColorSpace(previous);
+	};
+
+	if (bands == 1)
+		task(0);
+	else
+		pool->run(bands, task);
+}
+
+
+void HQxMap::render(
+	const HQx &scaler,
+	const HQxRect &rect,
+	uint32_t *output,
+	uint32_t outputStride ) const
+{
+	uint32_t factor = scaler.getFactor();
+
+	for (uint32_t y = 0; y < rect.height; ++y)
+	{
+		const uint16_t *values = map.data() + (size_t) (rect.y + y) * width + rect.x;
+		uint32_t *target = output + (size_t) y * factor * outputStride;
+		for (uint32_t x = 0; x < rect.width; ++x)
+		{
+			// the comparisons made by the interpolation come from the map
+			uint32_t w[9];
+			getWindow(rect.x + x, rect.y + y, w);
+			HQx::setEdges(w, values[x] >> 8);
+			scaler.interpolate(values[x] & 0xFF, w, target, (int) outputStride, trY, trU, trV,
+				trA);
+			target += factor;
+		}
+	}
+	HQx::setEdges(NULL, 0);
+}
+
+
+void HQxMap::setColorSpace(
+	HQxColorSpace colorSpace )
+{
+	this->colorSpace = colorSpace;
+}
+
+
+HQxColorSpace HQxMap::getColorSpace() const
+{
+	return colorSpace;
+}
+
+
+const std::vector<uint16_t> &HQxMap::getMap() const
+{
+	return map;
+}
+
+
+uint32_t HQxMap::getWidth() const
+{
+	return width;
+}
+
+
+uint32_t HQxMap::getHeight() const
+{
+	return height;
+}
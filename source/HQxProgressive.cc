@@ -0,0 +1,205 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hqx/HQxProgressive.hh>
+#include <algorithm>
+#include <cstring>
+
+
+/*
+ * Returns the distance between a range and a position outside of it (zero if
+ * the position is inside).
+ */
+static inline int64_t hqx_gap(
+	int64_t first,
+	int64_t last,
+	int64_t position )
+{
+	if (position < first) return first - position;
+	if (position > last) return position - last;
+	return 0;
+}
+
+
+HQxProgressive::HQxProgressive(
+	const HQx &scaler,
+	uint32_t tileSize ) : scaler(scaler), tileSize((tileSize > 0) ? tileSize : 64),
+		image(NULL), width(0), height(0), output(NULL), trY(0), trU(0), trV(0), trA(0),
+		wrapX(false), wrapY(false), tileCount(0), refined(0), cancelled(false)
+{
+	viewport.x = viewport.y = viewport.width = viewport.height = 0;
+}
+
+
+HQxProgressive::~HQxProgressive()
+{
+	cancel();
+}
+
+
+void HQxProgressive::start(
+	const uint32_t *image,
+	uint32_t width,
+	uint32_t height,
+	uint32_t *output,
+	const HQxRect &viewport,
+	const Callback &callback,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA,
+	bool wrapX,
+	bool wrapY )
+{
+	cancel();
+
+	this->image = image;
+	this->width = width;
+	this->height = height;
+	this->output = output;
+	this->viewport = viewport;
+	this->callback = callback;
+	this->trY = trY;
+	this->trU = trU;
+	this->trV = trV;
+	this->trA = trA;
+	this->wrapX = wrapX;
+	this->wrapY = wrapY;
+
+	// the preview replicates each source pixel, which is bound by the memory bandwidth
+	uint32_t factor = scaler.getFactor();
+	size_t outputWidth = (size_t) width * factor;
+	for (uint32_t y = 0; y < height; ++y)
+	{
+		const uint32_t *source = image + (size_t) y * width;
+		uint32_t *target = output + (size_t) y * factor * outputWidth;
+		for (uint32_t x = 0; x < width; ++x)
+			std::fill_n(target + (size_t) x * factor, factor, source[x]);
+		for (uint32_t i = 1; i < factor; ++i)
+			memcpy(target + i * outputWidth, target, outputWidth * sizeof(uint32_t));
+	}
+
+	pending.clear();
+	for (uint32_t y = 0; y < height; y += tileSize)
+		for (uint32_t x = 0; x < width; x += tileSize)
+		{
+			HQxRect tile = { x, y, std::min(tileSize, width - x), std::min(tileSize, height - y) };
+			pending.push_back(tile);
+		}
+	tileCount = (uint32_t) pending.size();
+	refined = 0;
+	cancelled = false;
+
+	worker = std::thread(&HQxProgressive::work, this);
+}
+
+
+void HQxProgressive::setViewport(
+	const HQxRect &viewport )
+{
+	std::lock_guard<std::mutex> guard(lock);
+	this->viewport = viewport;
+}
+
+
+bool HQxProgressive::next(
+	HQxRect &tile )
+{
+	std::lock_guard<std::mutex> guard(lock);
+	if (pending.empty()) return false;
+
+	// the tiles which intersect the viewport first, then by the distance to its
+	// center (in doubled coordinates, so the centers are integers)
+	int64_t left = 2 * (int64_t) viewport.x;
+	int64_t top = 2 * (int64_t) viewport.y;
+	int64_t right = left + 2 * (int64_t) viewport.width;
+	int64_t bottom = top + 2 * (int64_t) viewport.height;
+	int64_t centerX = (left + right) / 2;
+	int64_t centerY = (top + bottom) / 2;
+	size_t best = 0;
+	int64_t bestGap = 0, bestDistance = 0;
+	for (size_t i = 0; i < pending.size(); ++i)
+	{
+		const HQxRect &rect = pending[i];
+		int64_t x = 2 * (int64_t) rect.x + rect.width;
+		int64_t y = 2 * (int64_t) rect.y + rect.height;
+		int64_t gapX = hqx_gap(left - rect.width, right + rect.width, x);
+		int64_t gapY = hqx_gap(top - rect.height, bottom + rect.height, y);
+		int64_t gap = gapX * gapX + gapY * gapY;
+		int64_t distance = (x - centerX) * (x - centerX) + (y - centerY) * (y - centerY);
+		if (i == 0 || gap < bestGap || (gap == bestGap && distance < bestDistance))
+		{
+			best = i;
+			bestGap = gap;
+			bestDistance = distance;
+		}
+	}
+
+	tile = pending[best];
+	pending[best] = pending.back();
+	pending.pop_back();
+	return true;
+}
+
+
+void HQxProgressive::work()
+{
+	uint32_t factor = scaler.getFactor();
+	size_t outputWidth = (size_t) width * factor;
+	const HQx *scalers = &scaler;
+
+	HQxRect tile;
+	while (!cancelled && next(tile))
+	{
+		uint32_t *first = output + (size_t) tile.y * factor * outputWidth + tile.x * factor;
+		HQx::processRows(&scalers, 1, image, width, height, width, &first, 0, tile.y,
+			tile.y + tile.height, tile.x, tile.x + tile.width, trY, trU, trV, trA, wrapX, wrapY,
+			false, scaler.colorSpace, scaler.alphaMode, scaler.quality, scaler.memoization);
+		++refined;
+		if (callback) callback(tile);
+	}
+}
+
+
+void HQxProgressive::cancel()
+{
+	cancelled = true;
+	if (worker.joinable()) worker.join();
+}
+
+
+void HQxProgressive::wait()
+{
+	if (worker.joinable()) worker.join();
+}
+
+
+bool HQxProgressive::isFinished() const
+{
+	return refined == tileCount;
+}
+
+
+uint32_t HQxProgressive::getTileCount() const
+{
+	return tileCount;
+}
+
+
+uint32_t HQxProgressive::getRefinedTiles() const
+{
+	return refined;
+}
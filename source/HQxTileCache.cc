@@ -0,0 +1,234 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hqx/HQxTileCache.hh>
+#include <algorithm>
+#include <cstring>
+
+
+/*
+ * Returns the position of the source pixel used for the given position, which
+ * may be one pixel outside of the image.
+ */
+static inline uint32_t hqx_border(
+	int64_t position,
+	uint32_t size,
+	bool wrap )
+{
+	if (position < 0) return (wrap) ? size - 1 : 0;
+	if (position >= size) return (wrap) ? 0 : size - 1;
+	return (uint32_t) position;
+}
+
+
+static inline uint64_t hqx_hash(
+	const uint32_t *pixels,
+	size_t count,
+	uint64_t seed )
+{
+	uint64_t hash = seed;
+	for (size_t i = 0; i < count; ++i)
+		hash = (((hash << 5) | (hash >> 59)) ^ pixels[i]) * 0x9E3779B97F4A7C15ULL;
+	return hash ^ (hash >> 32);
+}
+
+
+HQxTileCache::HQxTileCache(
+	const HQx &scaler,
+	size_t capacity,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA ) : scaler(scaler), capacity(capacity), trY(trY), trU(trU), trV(trV),
+		trA(trA)
+{
+	memset(&stats, 0, sizeof(stats));
+}
+
+
+HQxTileCache::~HQxTileCache()
+{
+	// nothing to do
+}
+
+
+void HQxTileCache::draw(
+	const uint32_t *image,
+	uint32_t width,
+	uint32_t height,
+	const HQxRect &tile,
+	uint32_t *output,
+	bool wrapX,
+	bool wrapY )
+{
+	if (tile.width == 0 || tile.height == 0) return;
+
+	// copies the tile and its ring, with the same borders used by the scalers
+	uint32_t sourceWidth = tile.width + 2;
+	uint32_t sourceHeight = tile.height + 2;
+	source.resize((size_t) sourceWidth * sourceHeight);
+	for (uint32_t y = 0; y < sourceHeight; ++y)
+	{
+		const uint32_t *row = image + (size_t) hqx_border((int64_t) tile.y + y - 1, height,
+			wrapY) * width;
+		uint32_t *target = source.data() + (size_t) y * sourceWidth;
+		target[0] = row[hqx_border((int64_t) tile.x - 1, width, wrapX)];
+		memcpy(target + 1, row + tile.x, tile.width * sizeof(uint32_t));
+		target[sourceWidth - 1] = row[hqx_border((int64_t) tile.x + tile.width, width, wrapX)];
+	}
+
+	uint32_t factor = scaler.getFactor();
+	uint32_t tileWidth = tile.width * factor;
+	uint32_t tileHeight = tile.height * factor;
+	// the settings of the scaler which change the output are part of the key
+	HQxColorSpace colorSpace = scaler.colorSpace;
+	HQxAlphaMode alphaMode = scaler.alphaMode;
+	HQxQuality quality = scaler.quality;
+	uint64_t settings = ((uint64_t) colorSpace << 16) | ((uint64_t) alphaMode << 8) |
+		(uint64_t) quality;
+	uint64_t hash = hqx_hash(source.data(), source.size(), ((uint64_t) tile.width << 40) ^
+		((uint64_t) tile.height << 20) ^ settings);
+
+	std::list<Entry>::iterator entry = entries.end();
+	auto range = index.equal_range(hash);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (it->second->width == tile.width && it->second->height == tile.height &&
+			it->second->colorSpace == colorSpace && it->second->alphaMode == alphaMode &&
+			it->second->quality == quality && it->second->source == source)
+		{
+			entry = it->second;
+			break;
+		}
+	}
+
+	if (entry != entries.end())
+	{
+		++stats.hits;
+		entries.splice(entries.begin(), entries, entry);
+	}
+	else
+	{
+		++stats.misses;
+
+		entries.push_front(Entry());
+		entry = entries.begin();
+		entry->hash = hash;
+		entry->width = tile.width;
+		entry->height = tile.height;
+		entry->colorSpace = colorSpace;
+		entry->alphaMode = alphaMode;
+		entry->quality = quality;
+		entry->source = source;
+		entry->output.resize((size_t) tileWidth * tileHeight);
+
+		// resizes only the tile, the ring is used just by its windows
+		uint32_t *first = entry->output.data();
+		const HQx *scalers = &scaler;
+		HQx::processRows(&scalers, 1, source.data(), sourceWidth, sourceHeight, sourceWidth,
+			&first, tileWidth, 1, sourceHeight - 1, 1, sourceWidth - 1, trY, trU, trV, trA, false,
+			false, false, colorSpace, alphaMode, quality, false);
+		index.insert(std::make_pair(hash, entry));
+
+		stats.entries++;
+		stats.memory += sizeof(Entry) + (entry->source.size() + entry->output.size()) *
+			sizeof(uint32_t);
+	}
+
+	size_t outputWidth = (size_t) width * factor;
+	uint32_t *target = output + (size_t) tile.y * factor * outputWidth + tile.x * factor;
+	for (uint32_t y = 0; y < tileHeight; ++y)
+		memcpy(target + y * outputWidth, entry->output.data() + (size_t) y * tileWidth,
+			tileWidth * sizeof(uint32_t));
+
+	evict();
+}
+
+
+void HQxTileCache::drawTiles(
+	const uint32_t *image,
+	uint32_t width,
+	uint32_t height,
+	uint32_t tileWidth,
+	uint32_t tileHeight,
+	uint32_t *output,
+	bool wrapX,
+	bool wrapY )
+{
+	if (tileWidth == 0 || tileHeight == 0) return;
+
+	for (uint32_t y = 0; y < height; y += tileHeight)
+		for (uint32_t x = 0; x < width; x += tileWidth)
+		{
+			HQxRect tile = { x, y, std::min(tileWidth, width - x), std::min(tileHeight,
+				height - y) };
+			draw(image, width, height, tile, output, wrapX, wrapY);
+		}
+}
+
+
+void HQxTileCache::evict()
+{
+	// the most recently used tile is kept even if it alone exceeds the limit
+	while (stats.memory > capacity && entries.size() > 1)
+	{
+		Entry &entry = entries.back();
+		auto range = index.equal_range(entry.hash);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			if (&*it->second == &entry)
+			{
+				index.erase(it);
+				break;
+			}
+		}
+		stats.memory -= sizeof(Entry) + (entry.source.size() + entry.output.size()) *
+			sizeof(uint32_t);
+		stats.entries--;
+		stats.evictions++;
+		entries.pop_back();
+	}
+}
+
+
+void HQxTileCache::clear()
+{
+	entries.clear();
+	index.clear();
+	stats.entries = 0;
+	stats.memory = 0;
+}
+
+
+const HQxTileCacheStats &HQxTileCache::getStats() const
+{
+	return stats;
+}
+
+
+double HQxTileCache::getHitRate() const
+{
+	uint64_t total = stats.hits + stats.misses;
+	return (total > 0) ? (double) stats.hits / (double) total : 0.0;
+}
+
+
+void HQxTileCache::resetStats()
+{
+	stats.hits = 0;
+	stats.misses = 0;
+	stats.evictions = 0;
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PerfCounters.hh"
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+#ifdef __linux__
+
+static int perf_open(
+	uint32_t type,
+	uint64_t config )
+{
+	struct perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = type;
+	attr.config = config;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+	return (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+#endif
+
+
+PerfCounters::PerfCounters() : error(ENOSYS)
+{
+	for (int i = 0; i < EVENT_COUNT; ++i)
+	{
+		fds[i] = -1;
+		values[i] = 0;
+	}
+
+#ifdef __linux__
+	static const uint64_t L1D_READ_MISS = PERF_COUNT_HW_CACHE_L1D |
+		(PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+	static const uint32_t TYPES[EVENT_COUNT] = { PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+		PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE };
+	static const uint64_t CONFIGS[EVENT_COUNT] = { PERF_COUNT_HW_CPU_CYCLES,
+		PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES, L1D_READ_MISS,
+		PERF_COUNT_HW_CACHE_MISSES };
+
+	// keeps the first error to explain why the counters are unavailable
+	error = 0;
+	for (int i = 0; i < EVENT_COUNT; ++i)
+	{
+		fds[i] = perf_open(TYPES[i], CONFIGS[i]);
+		if (fds[i] < 0 && error == 0) error = errno;
+	}
+	if (isAvailable()) error = 0;
+#endif
+}
+
+
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+	for (int i = 0; i < EVENT_COUNT; ++i)
+		if (fds[i] >= 0) close(fds[i]);
+#endif
+}
+
+
+bool PerfCounters::isAvailable() const
+{
+	for (int i = 0; i < EVENT_COUNT; ++i)
+		if (fds[i] >= 0) return true;
+	return false;
+}
+
+
+bool PerfCounters::isAvailable(
+	int event ) const
+{
+	return event >= 0 && event < EVENT_COUNT && fds[event] >= 0;
+}
+
+
+const char *PerfCounters::getError() const
+{
+	return strerror(error);
+}
+
+
+void PerfCounters::start()
+{
+#ifdef __linux__
+	for (int i = 0; i < EVENT_COUNT; ++i)
+	{
+		if (fds[i] < 0) continue;
+		ioctl(fds[i], PERF_EVENT_IOC_RESET, 0);
+		ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+	}
+#endif
+}
+
+
+void PerfCounters::stop()
+{
+#ifdef __linux__
+	for (int i = 0; i < EVENT_COUNT; ++i)
+	{
+		values[i] = 0;
+		if (fds[i] < 0) continue;
+		ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+
+		// value, time enabled and time running
+		uint64_t data[3];
+		if (read(fds[i], data, sizeof(data)) != (ssize_t) sizeof(data)) continue;
+		if (data[2] > 0 && data[2] < data[1])
+			values[i] = (uint64_t) ((double) data[0] * (double) data[1] / (double) data[2]);
+		else
+			values[i] = data[0];
+	}
+#endif
+}
+
+
+uint64_t PerfCounters::get(
+	int event ) const
+{
+	if (event < 0 || event >= EVENT_COUNT) return 0;
+	return values[event];
+}
+
+
+const char *PerfCounters::getName(
+	int event )
+{
+	static const char *NAMES[] = { "cycles", "instructions", "branch_misses",
+		"l1d_misses", "llc_misses" };
+	if (event < 0 || event >= EVENT_COUNT) return "";
+	return NAMES[event];
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HQX_PERFCOUNTERS_HH
+#define HQX_PERFCOUNTERS_HH
+
+
+#include <stdint.h>
+
+
+/**
+ * @brief Hardware performance counters of the calling thread (Linux perf events).
+ *
+ * Every counter is opened independently, so the ones not supported by the
+ * machine (or not allowed, as usual in containers) are just unavailable.
+ */
+class PerfCounters
+{
+	public:
+		enum Event
+		{
+			CYCLES,
+			INSTRUCTIONS,
+			BRANCH_MISSES,
+			L1D_MISSES,
+			LLC_MISSES,
+			EVENT_COUNT
+		};
+
+		PerfCounters();
+
+		~PerfCounters();
+
+		/**
+		 * @brief Returns whether at least one counter is available.
+		 */
+		bool isAvailable() const;
+
+		bool isAvailable(
+			int event ) const;
+
+		/**
+		 * @brief Returns the reason why no counter is available.
+		 */
+		const char *getError() const;
+
+		void start();
+
+		void stop();
+
+		/**
+		 * @brief Returns the value of the counter between the last calls to
+		 * @c start and @c stop (scaled if the counter was multiplexed).
+		 */
+		uint64_t get(
+			int event ) const;
+
+		static const char *getName(
+			int event );
+
+	private:
+		int fds[EVENT_COUNT];
+		uint64_t values[EVENT_COUNT];
+		int error;
+
+		PerfCounters( const PerfCounters& );
+
+		PerfCounters &operator=( const PerfCounters& );
+};
+
+
+#endif  // HQX_PERFCOUNTERS_HH
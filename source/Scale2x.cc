@@ -0,0 +1,205 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hqx/Scale2x.hh>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SCALE_SSE2
+#include <emmintrin.h>
+#endif
+
+
+/*
+ * Writes the output block of one pixel, where B, D, F and H are the pixels
+ * above, on the left, on the right and below E.
+ *
+ *   E0 E1
+ *   E2 E3
+ */
+static inline void scale2x_pixel(
+	uint32_t B,
+	uint32_t D,
+	uint32_t E,
+	uint32_t F,
+	uint32_t H,
+	uint32_t *output0,
+	uint32_t *output1 )
+{
+	if (B != H && D != F)
+	{
+		output0[0] = (D == B) ? D : E;
+		output0[1] = (B == F) ? F : E;
+		output1[0] = (D == H) ? D : E;
+		output1[1] = (H == F) ? F : E;
+	}
+	else
+		output0[0] = output0[1] = output1[0] = output1[1] = E;
+}
+
+
+#ifdef SCALE_SSE2
+
+/*
+ * Returns the lanes of 'a' where the mask is set and the lanes of 'b' elsewhere.
+ */
+static inline __m128i scale_select(
+	__m128i mask,
+	__m128i a,
+	__m128i b )
+{
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+#endif
+
+
+/*
+ * Scales the columns in the range [first, last) of one row. The columns must
+ * have both neighbors in the row, so the borders are handled by the caller.
+ */
+static void scale2x_row(
+	const uint32_t *above,
+	const uint32_t *line,
+	const uint32_t *below,
+	uint32_t first,
+	uint32_t last,
+	uint32_t *output0,
+	uint32_t *output1 )
+{
+	uint32_t x = first;
+
+#ifdef SCALE_SSE2
+	// four pixels at a time, each one producing two pixels in both output rows
+	for (; x + 4 <= last; x += 4)
+	{
+		__m128i B = _mm_loadu_si128((const __m128i*) (above + x));
+		__m128i D = _mm_loadu_si128((const __m128i*) (line + x - 1));
+		__m128i E = _mm_loadu_si128((const __m128i*) (line + x));
+		__m128i F = _mm_loadu_si128((const __m128i*) (line + x + 1));
+		__m128i H = _mm_loadu_si128((const __m128i*) (below + x));
+
+		// the lanes where the block is just E
+		__m128i copy = _mm_or_si128(_mm_cmpeq_epi32(B, H), _mm_cmpeq_epi32(D, F));
+		__m128i E0 = scale_select(_mm_andnot_si128(copy, _mm_cmpeq_epi32(D, B)), D, E);
+		__m128i E1 = scale_select(_mm_andnot_si128(copy, _mm_cmpeq_epi32(B, F)), F, E);
+		__m128i E2 = scale_select(_mm_andnot_si128(copy, _mm_cmpeq_epi32(D, H)), D, E);
+		__m128i E3 = scale_select(_mm_andnot_si128(copy, _mm_cmpeq_epi32(H, F)), F, E);
+
+		_mm_storeu_si128((__m128i*) (output0 + x * 2), _mm_unpacklo_epi32(E0, E1));
+		_mm_storeu_si128((__m128i*) (output0 + x * 2 + 4), _mm_unpackhi_epi32(E0, E1));
+		_mm_storeu_si128((__m128i*) (output1 + x * 2), _mm_unpacklo_epi32(E2, E3));
+		_mm_storeu_si128((__m128i*) (output1 + x * 2 + 4), _mm_unpackhi_epi32(E2, E3));
+	}
+#endif
+
+	for (; x < last; ++x)
+		scale2x_pixel(above[x], line[x - 1], line[x], line[x + 1], below[x], output0 + x * 2,
+			output1 + x * 2);
+}
+
+
+Scale2x::Scale2x()
+{
+	// nothing to do
+}
+
+
+Scale2x::~Scale2x()
+{
+	// nothing to do
+}
+
+
+uint32_t Scale2x::getFactor() const
+{
+	return 2;
+}
+
+
+bool Scale2x::usesPattern() const
+{
+	return false;
+}
+
+
+uint32_t *Scale2x::resize(
+	const uint32_t *image,
+	uint32_t width,
+	uint32_t height,
+	uint32_t *output,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA,
+	bool wrapX,
+	bool wrapY ) const
+{
+	if (width < 3 || getTransform() != HQX_IDENTITY || getFilter() != NULL ||
+		getAlphaMode() != HQX_ALPHA_STRAIGHT)
+		return resizeRows(image, width, height, output, 0, height, trY, trU, trV, trA, wrapX, wrapY);
+
+	// the border columns are wrapped or replicated like in the other scalers
+	const HQx *scaler = this;
+	uint32_t *left = output;
+	uint32_t *right = output + (width - 1) * 2;
+	processRows(&scaler, 1, image, width, height, width, &left, 0, 0, height, 0, 1, trY, trU,
+		trV, trA, wrapX, wrapY, false, HQX_ARGB, HQX_ALPHA_STRAIGHT, quality, false);
+	processRows(&scaler, 1, image, width, height, width, &right, 0, 0, height, width - 1, width,
+		trY, trU, trV, trA, wrapX, wrapY, false, HQX_ARGB, HQX_ALPHA_STRAIGHT, quality, false);
+
+	size_t outputWidth = (size_t) width * 2;
+	for (uint32_t row = 0; row < height; ++row)
+	{
+		const uint32_t *line = image + (size_t) row * width;
+		const uint32_t *above = line;
+		const uint32_t *below = line;
+		if (row > 0)
+			above = line - width;
+		else
+		if (wrapY)
+			above = image + (size_t) (height - 1) * width;
+		if (row < height - 1)
+			below = line + width;
+		else
+		if (wrapY)
+			below = image;
+
+		uint32_t *output0 = output + (size_t) row * 2 * outputWidth;
+		scale2x_row(above, line, below, 1, width - 1, output0, output0 + outputWidth);
+	}
+
+	return output + (size_t) height * width * 4;
+}
+
+
+void Scale2x::interpolate(
+	int pattern,
+	const uint32_t *w,
+	uint32_t *output,
+	int lineSize,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA ) const
+{
+	(void) pattern;
+	(void) trY;
+	(void) trU;
+	(void) trV;
+	(void) trA;
+
+	scale2x_pixel(w[1], w[3], w[4], w[5], w[7], output, output + lineSize);
+}
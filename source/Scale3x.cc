@@ -0,0 +1,270 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hqx/Scale3x.hh>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SCALE_SSE2
+#include <emmintrin.h>
+#endif
+
+
+/*
+ * Writes the output block of one pixel with the window
+ *
+ *   A B C        E0 E1 E2
+ *   D E F  --->  E3 E4 E5
+ *   G H I        E6 E7 E8
+ */
+static inline void scale3x_pixel(
+	const uint32_t *w,
+	uint32_t *output0,
+	uint32_t *output1,
+	uint32_t *output2 )
+{
+	uint32_t A = w[0], B = w[1], C = w[2];
+	uint32_t D = w[3], E = w[4], F = w[5];
+	uint32_t G = w[6], H = w[7], I = w[8];
+
+	if (B != H && D != F)
+	{
+		output0[0] = (D == B) ? D : E;
+		output0[1] = ((D == B && E != C) || (B == F && E != A)) ? B : E;
+		output0[2] = (B == F) ? F : E;
+		output1[0] = ((D == B && E != G) || (D == H && E != A)) ? D : E;
+		output1[1] = E;
+		output1[2] = ((B == F && E != I) || (H == F && E != C)) ? F : E;
+		output2[0] = (D == H) ? D : E;
+		output2[1] = ((D == H && E != I) || (H == F && E != G)) ? H : E;
+		output2[2] = (H == F) ? F : E;
+	}
+	else
+	{
+		output0[0] = output0[1] = output0[2] = E;
+		output1[0] = output1[1] = output1[2] = E;
+		output2[0] = output2[1] = output2[2] = E;
+	}
+}
+
+
+#ifdef SCALE_SSE2
+
+/*
+ * Returns the lanes of 'a' where the mask is set and the lanes of 'b' elsewhere.
+ */
+static inline __m128i scale_select(
+	__m128i mask,
+	__m128i a,
+	__m128i b )
+{
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+
+/*
+ * Stores the lanes of three vectors interleaved (a0 b0 c0 a1 b1 c1 ...).
+ */
+static inline void scale_store3(
+	uint32_t *output,
+	__m128i a,
+	__m128i b,
+	__m128i c )
+{
+	__m128 ab0 = _mm_castsi128_ps(_mm_unpacklo_epi32(a, b));  // a0 b0 a1 b1
+	__m128 ab1 = _mm_castsi128_ps(_mm_unpackhi_epi32(a, b));  // a2 b2 a3 b3
+	__m128 bc0 = _mm_castsi128_ps(_mm_unpacklo_epi32(b, c));  // b0 c0 b1 c1
+	__m128 bc1 = _mm_castsi128_ps(_mm_unpackhi_epi32(b, c));  // b2 c2 b3 c3
+	__m128 ca0 = _mm_castsi128_ps(_mm_unpacklo_epi32(c, a));  // c0 a0 c1 a1
+	__m128 ca1 = _mm_castsi128_ps(_mm_unpackhi_epi32(c, a));  // c2 a2 c3 a3
+
+	_mm_storeu_ps((float*) output, _mm_shuffle_ps(ab0, ca0, _MM_SHUFFLE(3, 0, 1, 0)));
+	_mm_storeu_ps((float*) output + 4, _mm_shuffle_ps(bc0, ab1, _MM_SHUFFLE(1, 0, 3, 2)));
+	_mm_storeu_ps((float*) output + 8, _mm_shuffle_ps(ca1, bc1, _MM_SHUFFLE(3, 2, 3, 0)));
+}
+
+#endif
+
+
+/*
+ * Scales the columns in the range [first, last) of one row. The columns must
+ * have both neighbors in the row, so the borders are handled by the caller.
+ */
+static void scale3x_row(
+	const uint32_t *above,
+	const uint32_t *line,
+	const uint32_t *below,
+	uint32_t first,
+	uint32_t last,
+	uint32_t *output0,
+	uint32_t *output1,
+	uint32_t *output2 )
+{
+	uint32_t x = first;
+
+#ifdef SCALE_SSE2
+	// four pixels at a time, each one producing three pixels in the three output rows
+	for (; x + 4 <= last; x += 4)
+	{
+		__m128i A = _mm_loadu_si128((const __m128i*) (above + x - 1));
+		__m128i B = _mm_loadu_si128((const __m128i*) (above + x));
+		__m128i C = _mm_loadu_si128((const __m128i*) (above + x + 1));
+		__m128i D = _mm_loadu_si128((const __m128i*) (line + x - 1));
+		__m128i E = _mm_loadu_si128((const __m128i*) (line + x));
+		__m128i F = _mm_loadu_si128((const __m128i*) (line + x + 1));
+		__m128i G = _mm_loadu_si128((const __m128i*) (below + x - 1));
+		__m128i H = _mm_loadu_si128((const __m128i*) (below + x));
+		__m128i I = _mm_loadu_si128((const __m128i*) (below + x + 1));
+
+		// the lanes where the block is just E
+		__m128i copy = _mm_or_si128(_mm_cmpeq_epi32(B, H), _mm_cmpeq_epi32(D, F));
+		__m128i DB = _mm_andnot_si128(copy, _mm_cmpeq_epi32(D, B));
+		__m128i BF = _mm_andnot_si128(copy, _mm_cmpeq_epi32(B, F));
+		__m128i DH = _mm_andnot_si128(copy, _mm_cmpeq_epi32(D, H));
+		__m128i HF = _mm_andnot_si128(copy, _mm_cmpeq_epi32(H, F));
+		__m128i EA = _mm_cmpeq_epi32(E, A);
+		__m128i EC = _mm_cmpeq_epi32(E, C);
+		__m128i EG = _mm_cmpeq_epi32(E, G);
+		__m128i EI = _mm_cmpeq_epi32(E, I);
+
+		__m128i E0 = scale_select(DB, D, E);
+		__m128i E1 = scale_select(_mm_or_si128(_mm_andnot_si128(EC, DB),
+			_mm_andnot_si128(EA, BF)), B, E);
+		__m128i E2 = scale_select(BF, F, E);
+		__m128i E3 = scale_select(_mm_or_si128(_mm_andnot_si128(EG, DB),
+			_mm_andnot_si128(EA, DH)), D, E);
+		__m128i E5 = scale_select(_mm_or_si128(_mm_andnot_si128(EI, BF),
+			_mm_andnot_si128(EC, HF)), F, E);
+		__m128i E6 = scale_select(DH, D, E);
+		__m128i E7 = scale_select(_mm_or_si128(_mm_andnot_si128(EI, DH),
+			_mm_andnot_si128(EG, HF)), H, E);
+		__m128i E8 = scale_select(HF, F, E);
+
+		scale_store3(output0 + x * 3, E0, E1, E2);
+		scale_store3(output1 + x * 3, E3, E, E5);
+		scale_store3(output2 + x * 3, E6, E7, E8);
+	}
+#endif
+
+	uint32_t w[9];
+	for (; x < last; ++x)
+	{
+		w[0] = above[x - 1];
+		w[1] = above[x];
+		w[2] = above[x + 1];
+		w[3] = line[x - 1];
+		w[4] = line[x];
+		w[5] = line[x + 1];
+		w[6] = below[x - 1];
+		w[7] = below[x];
+		w[8] = below[x + 1];
+		scale3x_pixel(w, output0 + x * 3, output1 + x * 3, output2 + x * 3);
+	}
+}
+
+
+Scale3x::Scale3x()
+{
+	// nothing to do
+}
+
+
+Scale3x::~Scale3x()
+{
+	// nothing to do
+}
+
+
+uint32_t Scale3x::getFactor() const
+{
+	return 3;
+}
+
+
+bool Scale3x::usesPattern() const
+{
+	return false;
+}
+
+
+uint32_t *Scale3x::resize(
+	const uint32_t *image,
+	uint32_t width,
+	uint32_t height,
+	uint32_t *output,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA,
+	bool wrapX,
+	bool wrapY ) const
+{
+	if (width < 3 || getTransform() != HQX_IDENTITY || getFilter() != NULL ||
+		getAlphaMode() != HQX_ALPHA_STRAIGHT)
+		return resizeRows(image, width, height, output, 0, height, trY, trU, trV, trA, wrapX, wrapY);
+
+	// the border columns are wrapped or replicated like in the other scalers
+	const HQx *scaler = this;
+	uint32_t *left = output;
+	uint32_t *right = output + (width - 1) * 3;
+	processRows(&scaler, 1, image, width, height, width, &left, 0, 0, height, 0, 1, trY, trU,
+		trV, trA, wrapX, wrapY, false, HQX_ARGB, HQX_ALPHA_STRAIGHT, quality, false);
+	processRows(&scaler, 1, image, width, height, width, &right, 0, 0, height, width - 1, width,
+		trY, trU, trV, trA, wrapX, wrapY, false, HQX_ARGB, HQX_ALPHA_STRAIGHT, quality, false);
+
+	size_t outputWidth = (size_t) width * 3;
+	for (uint32_t row = 0; row < height; ++row)
+	{
+		const uint32_t *line = image + (size_t) row * width;
+		const uint32_t *above = line;
+		const uint32_t *below = line;
+		if (row > 0)
+			above = line - width;
+		else
+		if (wrapY)
+			above = image + (size_t) (height - 1) * width;
+		if (row < height - 1)
+			below = line + width;
+		else
+		if (wrapY)
+			below = image;
+
+		uint32_t *output0 = output + (size_t) row * 3 * outputWidth;
+		scale3x_row(above, line, below, 1, width - 1, output0, output0 + outputWidth,
+			output0 + outputWidth * 2);
+	}
+
+	return output + (size_t) height * width * 9;
+}
+
+
+void Scale3x::interpolate(
+	int pattern,
+	const uint32_t *w,
+	uint32_t *output,
+	int lineSize,
+	uint32_t trY,
+	uint32_t trU,
+	uint32_t trV,
+	uint32_t trA ) const
+{
+	(void) pattern;
+	(void) trY;
+	(void) trU;
+	(void) trV;
+	(void) trA;
+
+	scale3x_pixel(w, output, output + lineSize, output + lineSize * 2);
+}
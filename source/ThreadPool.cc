@@ -0,0 +1,111 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hqx/ThreadPool.hh>
+
+
+ThreadPool::ThreadPool(
+	uint32_t threads ) : task(NULL), taskCount(0), nextTask(0), busy(0),
+		generation(0), stopping(false)
+{
+	if (threads == 0) threads = std::thread::hardware_concurrency();
+	if (threads == 0) threads = 1;
+
+	for (uint32_t i = 1; i < threads; ++i)
+		workers.push_back( std::thread(&ThreadPool::work, this) );
+}
+
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		stopping = true;
+	}
+	wakeup.notify_all();
+
+	for (size_t i = 0; i < workers.size(); ++i)
+		workers[i].join();
+}
+
+
+uint32_t ThreadPool::getSize() const
+{
+	return (uint32_t) workers.size() + 1;
+}
+
+
+void ThreadPool::execute()
+{
+	uint32_t index;
+	while ((index = nextTask++) < taskCount)
+		(*task)(index);
+}
+
+
+void ThreadPool::work()
+{
+	uint64_t seen = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			while (!stopping && generation == seen) wakeup.wait(guard);
+			if (stopping) return;
+			seen = generation;
+		}
+
+		execute();
+
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			if (--busy == 0) finished.notify_one();
+		}
+	}
+}
+
+
+void ThreadPool::run(
+	uint32_t count,
+	const std::function<void(uint32_t)> &task )
+{
+	if (count == 0) return;
+
+	std::unique_lock<std::mutex> call(callLock);
+
+	if (workers.empty() || count == 1)
+	{
+		for (uint32_t i = 0; i < count; ++i) task(i);
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		this->task = &task;
+		taskCount = count;
+		nextTask = 0;
+		busy = (uint32_t) workers.size();
+		++generation;
+	}
+	wakeup.notify_all();
+
+	execute();
+
+	std::unique_lock<std::mutex> guard(lock);
+	while (busy > 0) finished.wait(guard);
+	this->task = NULL;
+}
@@ -0,0 +1,913 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hqx/HQ2x.hh>
+#include <hqx/HQ3x.hh>
+#include <hqx/HQ4x.hh>
+#include <hqx/HQxFilter.hh>
+#include <hqx/HQxGovernor.hh>
+#include <hqx/HQxMap.hh>
+#include <hqx/HQxProgressive.hh>
+#include <hqx/HQxTileCache.hh>
+#include <hqx/Scale2x.hh>
+#include <hqx/Scale3x.hh>
+#include <hqx/ThreadPool.hh>
+#include "Capture.hh"
+#include "Corpus.hh"
+#include "PerfCounters.hh"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+using std::string;
+
+
+// limits of the counts given in the command line
+static const uint32_t BENCH_MAX_COUNT = 1000000;
+static const uint32_t BENCH_MAX_THREADS = 1024;
+
+
+/**
+ * @brief Benchmark options given in the command line.
+ */
+struct BenchOptions
+{
+	uint32_t width;
+	uint32_t height;
+	uint32_t warmup;
+	uint32_t runs;
+	string jsonFile;
+	string className;
+	string generateDir;
+	/// Hardware counters (NULL if disabled or unavailable)
+	PerfCounters *perf;
+	/// Whether to run the thread scaling study
+	bool scaling;
+	/// Number of threads (maximum in the scaling study, zero for no pool in the replay)
+	uint32_t threads;
+	/// Capture file to replay
+	string replayFile;
+	/// Scale factor used in the replay
+	uint32_t factor;
+	/// Frames per second in the replay
+	double rate;
+	/// Number of times the capture is replayed
+	uint32_t loops;
+	/// Whether the replay keeps the frames within the budget with a governor
+	bool governor;
+};
+
+
+/**
+ * @brief Timings of one benchmark.
+ */
+struct BenchResult
+{
+	string name;
+	uint64_t pixels;
+	std::vector<double> samples;
+	double median;
+	double p99;
+	double minimum;
+	double throughput;
+	/// Hardware counters per source pixel (negative if unavailable)
+	double counters[PerfCounters::EVENT_COUNT];
+	/// Number of threads (zero for single-threaded benchmarks)
+	uint32_t threads;
+	/// Memory bandwidth in GB/s (zero if not measured)
+	double bandwidth;
+};
+
+
+// prevents the compiler from discarding the benchmarked code
+static volatile uint32_t bench_sink;
+
+
+/**
+ * @brief Returns the given percentile (nearest rank) of a sorted list.
+ */
+static double bench_percentile(
+	const std::vector<double> &sorted,
+	uint32_t percentile )
+{
+	size_t rank = (sorted.size() * percentile + 99) / 100;
+	return sorted[(rank > 0 ? rank : 1) - 1];
+}
+
+
+/**
+ * @brief Runs a benchmark and computes the timings in nanoseconds per pixel.
+ *
+ * The function @c body must process @c pixels pixels per call.
+ */
+template<typename F>
+BenchResult bench_run(
+	const BenchOptions &options,
+	const string &name,
+	uint64_t pixels,
+	F body )
+{
+	BenchResult result;
+	result.name = name;
+	result.pixels = pixels;
+	result.threads = 0;
+	result.bandwidth = 0;
+
+	for (uint32_t i = 0; i < options.warmup; ++i) body();
+
+	for (uint32_t i = 0; i < options.runs; ++i)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		body();
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		double ns = (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+		result.samples.push_back(ns / (double) pixels);
+	}
+
+	std::vector<double> sorted = result.samples;
+	std::sort(sorted.begin(), sorted.end());
+	result.minimum = sorted.front();
+	result.median = (sorted.size() % 2) ? sorted[sorted.size() / 2] :
+		(sorted[sorted.size() / 2 - 1] + sorted[sorted.size() / 2]) / 2;
+	result.p99 = bench_percentile(sorted, 99);
+	result.throughput = (result.median > 0) ? 1000.0 / result.median : 0;
+
+	printf("%-36s %12.3f %12.3f %12.3f %12.2f\n", name.c_str(), result.median,
+		result.p99, result.minimum, result.throughput);
+
+	// the counters are measured in a separate pass to not disturb the timings
+	for (int i = 0; i < PerfCounters::EVENT_COUNT; ++i) result.counters[i] = -1;
+	if (options.perf != NULL)
+	{
+		options.perf->start();
+		for (uint32_t i = 0; i < options.runs; ++i) body();
+		options.perf->stop();
+
+		double total = (double) pixels * options.runs;
+		printf("%-36s", "");
+		for (int i = 0; i < PerfCounters::EVENT_COUNT; ++i)
+		{
+			if (!options.perf->isAvailable(i)) continue;
+			result.counters[i] = (double) options.perf->get(i) / total;
+			printf(" %s %.2f", PerfCounters::getName(i), result.counters[i]);
+		}
+		if (result.counters[PerfCounters::CYCLES] > 0 && result.counters[PerfCounters::INSTRUCTIONS] >= 0)
+			printf(" ipc %.2f", result.counters[PerfCounters::INSTRUCTIONS] /
+				result.counters[PerfCounters::CYCLES]);
+		printf("\n");
+	}
+	fflush(stdout);
+	return result;
+}
+
+
+/**
+ * @brief Builds the 3x3 windows of every pixel (clamped at the borders).
+ */
+static void bench_createWindows(
+	const std::vector<uint32_t> &image,
+	uint32_t width,
+	uint32_t height,
+	std::vector<uint32_t> &windows )
+{
+	windows.resize(image.size() * 9);
+	uint32_t *w = windows.data();
+	for (uint32_t row = 0; row < height; ++row)
+		for (uint32_t col = 0; col < width; ++col, w += 9)
+			for (int k = 0; k < 9; ++k)
+			{
+				int y = (int) row + k / 3 - 1;
+				int x = (int) col + k % 3 - 1;
+				y = std::max(0, std::min(y, (int) height - 1));
+				x = std::max(0, std::min(x, (int) width - 1));
+				w[k] = image[y * width + x];
+			}
+}
+
+
+static void bench_writeJson(
+	const BenchOptions &options,
+	const std::vector<BenchResult> &results )
+{
+	std::ofstream output(options.jsonFile.c_str());
+	if (!output.good())
+	{
+		std::cerr << "Unable to write '" << options.jsonFile << "'" << std::endl;
+		return;
+	}
+
+	output << "{\n  \"width\": " << options.width << ",\n  \"height\": " << options.height
+		<< ",\n  \"warmup\": " << options.warmup << ",\n  \"runs\": " << options.runs
+		<< ",\n  \"benchmarks\": [\n";
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		const BenchResult &result = results[i];
+		output << "    { \"name\": \"" << result.name << "\", \"pixels\": " << result.pixels
+			<< ", \"median_ns_per_pixel\": " << result.median
+			<< ", \"p99_ns_per_pixel\": " << result.p99
+			<< ", \"min_ns_per_pixel\": " << result.minimum
+			<< ", \"mpix_per_s\": " << result.throughput;
+		for (int j = 0; j < PerfCounters::EVENT_COUNT; ++j)
+			if (result.counters[j] >= 0)
+				output << ", \"" << PerfCounters::getName(j) << "_per_pixel\": " << result.counters[j];
+		if (result.threads > 0)
+			output << ", \"threads\": " << result.threads;
+		if (result.bandwidth > 0)
+			output << ", \"gb_per_s\": " << result.bandwidth;
+		if (result.counters[PerfCounters::CYCLES] > 0 && result.counters[PerfCounters::INSTRUCTIONS] >= 0)
+			output << ", \"ipc\": " << result.counters[PerfCounters::INSTRUCTIONS] /
+				result.counters[PerfCounters::CYCLES];
+		output << " }"
+			<< ((i + 1 < results.size()) ? ",\n" : "\n");
+	}
+	output << "  ]\n}\n";
+}
+
+
+/**
+ * @brief Saves the images of the content classes as PAM files.
+ */
+static int bench_generate(
+	const BenchOptions &options,
+	const std::vector<CorpusSpec> &classes )
+{
+	std::vector<uint32_t> image;
+	char suffix[32];
+	snprintf(suffix, sizeof(suffix), "-%ux%u.pam", options.width, options.height);
+
+	for (size_t i = 0; i < classes.size(); ++i)
+	{
+		if (!options.className.empty() && options.className != classes[i].name) continue;
+
+		string fileName = options.generateDir + "/" + classes[i].name + suffix;
+		Corpus::generate(classes[i], options.width, options.height, image);
+		if (Corpus::savePam(fileName, image.data(), options.width, options.height) != 0)
+		{
+			std::cerr << "Unable to write '" << fileName << "'" << std::endl;
+			return 1;
+		}
+		std::cout << fileName << std::endl;
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief Measures the components of the scalers with pixel art, the typical
+ * input of hqx.
+ */
+static void bench_components(
+	const BenchOptions &options,
+	const std::vector<CorpusSpec> &classes,
+	std::vector<BenchResult> &results )
+{
+	uint64_t pixels = (uint64_t) options.width * options.height;
+	std::vector<uint32_t> image, windows;
+	Corpus::generate(classes[1], options.width, options.height, image);
+	bench_createWindows(image, options.width, options.height, windows);
+
+	// thresholds shifted like in HQx::resizeRows
+	const uint32_t trY = 0x30 << 16, trU = 0x07 << 8, trV = 0x06, trA = 0x50 << 24;
+
+	results.push_back( bench_run(options, "ARGBtoAYUV", pixels, [&]()
+	{
+		uint32_t value = 0;
+		for (size_t i = 0; i < image.size(); ++i) value += HQx::ARGBtoAYUV(image[i]);
+		bench_sink = value;
+	}) );
+	// compares every pixel with its right neighbor (as in the pattern build)
+	results.push_back( bench_run(options, "isDifferentSharp", pixels, [&]()
+	{
+		uint32_t value = 0;
+		for (size_t i = 0; i < windows.size(); i += 9)
+			value += HQx::isDifferentSharp(windows[i + 4], windows[i + 5], trY, trU, trV, trA);
+		bench_sink = value;
+	}) );
+	results.push_back( bench_run(options, "isDifferentSmooth", pixels, [&]()
+	{
+		uint32_t value = 0;
+		for (size_t i = 0; i < windows.size(); i += 9)
+			value += HQx::isDifferentSmooth(windows[i + 4], windows[i + 5], trY, trU, trV, trA);
+		bench_sink = value;
+	}) );
+	results.push_back( bench_run(options, "getPattern", pixels, [&]()
+	{
+		uint32_t value = 0;
+		for (size_t i = 0; i < windows.size(); i += 9)
+			value += (uint32_t) HQx::getPattern(&windows[i], trY, trU, trV, trA);
+		bench_sink = value;
+	}) );
+	results.push_back( bench_run(options, "HQX_MIX_2", pixels, [&]()
+	{
+		uint32_t value = 0;
+		for (size_t i = 0; i < windows.size(); i += 9)
+			value += HQX_MIX_2(windows[i + 4], windows[i + 5], 3U, 1U);
+		bench_sink = value;
+	}) );
+	results.push_back( bench_run(options, "HQX_MIX_3", pixels, [&]()
+	{
+		uint32_t value = 0;
+		for (size_t i = 0; i < windows.size(); i += 9)
+			value += HQX_MIX_3(windows[i + 4], windows[i + 3], windows[i + 1], 2U, 1U, 1U);
+		bench_sink = value;
+	}) );
+}
+
+
+/**
+ * @brief Measures the whole scalers with every content class.
+ */
+static void bench_classes(
+	const BenchOptions &options,
+	const std::vector<CorpusSpec> &classes,
+	std::vector<BenchResult> &results )
+{
+	uint32_t width = options.width;
+	uint32_t height = options.height;
+	uint64_t pixels = (uint64_t) width * height;
+	std::vector<uint32_t> image, output((size_t) pixels * 16), output2((size_t) pixels * 4);
+
+	HQ2x hq2x;
+	HQ3x hq3x;
+	HQ4x hq4x;
+	Scale2x scale2x;
+	Scale3x scale3x;
+	HQxPostProcess filter;
+	filter.addScanlines(0.3f, 3);
+	filter.addGamma(1.1f);
+	for (size_t i = 0; i < classes.size(); ++i)
+	{
+		if (!options.className.empty() && options.className != classes[i].name) continue;
+
+		Corpus::generate(classes[i], width, height, image);
+		std::vector<uint32_t> yuv(image.size());
+		std::vector<uint8_t> gray(image.size()), grayOutput(image.size() * 9);
+		for (size_t j = 0; j < image.size(); ++j)
+		{
+			yuv[j] = HQx::ARGBtoAYUV(image[j]);
+			gray[j] = (uint8_t) (yuv[j] >> 16);
+		}
+		// the image as an atlas of 16x16 sprites
+		std::vector<HQxRect> rects;
+		std::vector<uint32_t> sprite(16 * 16);
+		for (uint32_t y = 0; y < height; y += 16)
+			for (uint32_t x = 0; x < width; x += 16)
+			{
+				HQxRect rect = { x, y, std::min(16U, width - x), std::min(16U, height - y) };
+				rects.push_back(rect);
+			}
+		results.push_back( bench_run(options, string("HQ2x::resize/") + classes[i].name, pixels, [&]()
+		{
+			hq2x.resize(image.data(), width, height, output.data());
+			bench_sink = output[0];
+		}) );
+		results.push_back( bench_run(options, string("HQ3x::resize/") + classes[i].name, pixels, [&]()
+		{
+			hq3x.resize(image.data(), width, height, output.data());
+			bench_sink = output[0];
+		}) );
+		results.push_back( bench_run(options, string("HQ4x::resize/") + classes[i].name, pixels, [&]()
+		{
+			hq4x.resize(image.data(), width, height, output.data());
+			bench_sink = output[0];
+		}) );
+		// includes storing the image at the end of the buffer
+		results.push_back( bench_run(options, string("HQ3x::resizeInPlace/") + classes[i].name,
+			pixels, [&]()
+		{
+			std::copy(image.begin(), image.end(), output.begin() + pixels * 8);
+			hq3x.resizeInPlace(output.data(), width, height);
+			bench_sink = output[0];
+		}) );
+		results.push_back( bench_run(options, string("Scale2x::resize/") + classes[i].name,
+			pixels, [&]()
+		{
+			scale2x.resize(image.data(), width, height, output.data());
+			bench_sink = output[0];
+		}) );
+		results.push_back( bench_run(options, string("Scale3x::resize/") + classes[i].name,
+			pixels, [&]()
+		{
+			scale3x.resize(image.data(), width, height, output.data());
+			bench_sink = output[0];
+		}) );
+		results.push_back( bench_run(options, string("HQ3x::resizeGray/") + classes[i].name,
+			pixels, [&]()
+		{
+			hq3x.resizeGray(gray.data(), width, height, grayOutput.data());
+			bench_sink = grayOutput[0];
+		}) );
+		hq3x.setColorSpace(HQX_AYUV);
+		results.push_back( bench_run(options, string("HQ3x::resize(ayuv)/") + classes[i].name,
+			pixels, [&]()
+		{
+			hq3x.resize(yuv.data(), width, height, output.data());
+			bench_sink = output[0];
+		}) );
+		hq3x.setColorSpace(HQX_ARGB);
+		hq3x.setFilter(&filter);
+		results.push_back( bench_run(options, string("HQ3x::resize(postprocess)/") + classes[i].name,
+			pixels, [&]()
+		{
+			hq3x.resize(image.data(), width, height, output.data());
+			bench_sink = output[0];
+		}) );
+		hq3x.setFilter(NULL);
+		hq3x.setTransform(HQX_ROTATE_90);
+		results.push_back( bench_run(options, string("HQ3x::resize(rotate90)/") + classes[i].name,
+			pixels, [&]()
+		{
+			hq3x.resize(image.data(), width, height, output.data());
+			bench_sink = output[0];
+		}) );
+		hq3x.setTransform(HQX_IDENTITY);
+		HQxMap map;
+		results.push_back( bench_run(options, string("HQxMap::build/") + classes[i].name, pixels,
+			[&]()
+		{
+			map.build(image.data(), width, height);
+			bench_sink = map.getMap()[0];
+		}) );
+		results.push_back( bench_run(options, string("HQ3x+HQxMap::render/") + classes[i].name,
+			pixels, [&]()
+		{
+			HQxRect rect = { 0, 0, width, height };
+			map.render(hq3x, rect, output.data(), width * 3);
+			bench_sink = output[0];
+		}) );
+		// the preview alone (at most one tile is refined before the cancellation)
+		HQxProgressive progressive(hq3x, 32);
+		HQxRect viewport = { 0, 0, width, height };
+		results.push_back( bench_run(options, string("HQ3x+HQxProgressive(preview)/") +
+			classes[i].name, pixels, [&]()
+		{
+			progressive.start(image.data(), width, height, output.data(), viewport);
+			progressive.cancel();
+			bench_sink = output[0];
+		}) );
+		hq3x.setMemoization(true);
+		results.push_back( bench_run(options, string("HQ3x::resize(memo)/") + classes[i].name,
+			pixels, [&]()
+		{
+			hq3x.resize(image.data(), width, height, output.data());
+			bench_sink = output[0];
+		}) );
+		hq3x.setMemoization(false);
+		hq3x.setQuality(HQX_QUALITY_FAST);
+		results.push_back( bench_run(options, string("HQ3x::resize(fast)/") + classes[i].name,
+			pixels, [&]()
+		{
+			hq3x.resize(image.data(), width, height, output.data());
+			bench_sink = output[0];
+		}) );
+		hq3x.setQuality(HQX_QUALITY_FULL);
+		hq3x.setAlphaMode(HQX_ALPHA_SKIP);
+		results.push_back( bench_run(options, string("HQ3x::resize(alpha-skip)/") + classes[i].name,
+			pixels, [&]()
+		{
+			hq3x.resize(image.data(), width, height, output.data());
+			bench_sink = output[0];
+		}) );
+		hq3x.setAlphaMode(HQX_ALPHA_STRAIGHT);
+		results.push_back( bench_run(options, string("HQ3x::resizeTo(3.5x)/") + classes[i].name,
+			pixels, [&]()
+		{
+			hq3x.resizeTo(image.data(), width, height, output.data(), width * 7 / 2, height * 7 / 2);
+			bench_sink = output[0];
+		}) );
+		results.push_back( bench_run(options, string("HQ2x::resize(16x16 each)/") + classes[i].name,
+			pixels, [&]()
+		{
+			for (size_t r = 0; r < rects.size(); ++r)
+			{
+				const HQxRect &rect = rects[r];
+				for (uint32_t y = 0; y < rect.height; ++y)
+					memcpy(sprite.data() + y * rect.width, image.data() + (rect.y + y) * width +
+						rect.x, rect.width * sizeof(uint32_t));
+				hq2x.resize(sprite.data(), rect.width, rect.height, output.data());
+			}
+			bench_sink = output[0];
+		}) );
+		results.push_back( bench_run(options, string("HQ2x::resizeAtlas(16x16)/") + classes[i].name,
+			pixels, [&]()
+		{
+			hq2x.resizeAtlas(image.data(), width, height, output.data(), rects.data(),
+				(uint32_t) rects.size());
+			bench_sink = output[0];
+		}) );
+		// the same frame drawn again, so every tile is copied from the cache
+		HQxTileCache cache(hq2x, (size_t) 256 << 20);
+		results.push_back( bench_run(options, string("HQ2x+HQxTileCache(8x8)/") + classes[i].name,
+			pixels, [&]()
+		{
+			cache.drawTiles(image.data(), width, height, 8, 8, output.data());
+			bench_sink = output[0];
+		}) );
+		results.push_back( bench_run(options, string("HQ2x+HQ3x::resizeMultiple/") + classes[i].name,
+			pixels, [&]()
+		{
+			const HQx *scalers[] = { &hq2x, &hq3x };
+			uint32_t *outputs[] = { output2.data(), output.data() };
+			HQx::resizeMultiple(scalers, 2, image.data(), width, height, outputs);
+			bench_sink = output[0];
+		}) );
+	}
+}
+
+
+/**
+ * @brief Returns the class selected in the command line (pixel art by default).
+ */
+static const CorpusSpec &bench_selectClass(
+	const BenchOptions &options,
+	const std::vector<CorpusSpec> &classes )
+{
+	for (size_t i = 0; i < classes.size(); ++i)
+		if (options.className == classes[i].name) return classes[i];
+	return classes[1];
+}
+
+
+/**
+ * @brief Measures the parallel scalers with 1 to N threads.
+ *
+ * The output bandwidth of the scalers is compared with a STREAM-like copy
+ * using the same threads, which is the practical limit of the machine. The
+ * copy bandwidth counts read and written bytes (as STREAM does) while the
+ * scalers count only the written output, which dominates their traffic.
+ */
+static void bench_scaling(
+	const BenchOptions &options,
+	const std::vector<CorpusSpec> &classes,
+	std::vector<BenchResult> &results )
+{
+	// copy buffers much bigger than the last level cache
+	static const size_t COPY_SIZE = 16 * 1024 * 1024;
+
+	uint32_t width = options.width;
+	uint32_t height = options.height;
+	uint64_t pixels = (uint64_t) width * height;
+	const CorpusSpec &spec = bench_selectClass(options, classes);
+
+	std::vector<uint32_t> image, output((size_t) pixels * 9);
+	std::vector<uint32_t> copySource(COPY_SIZE, 1), copyTarget(COPY_SIZE, 0);
+	Corpus::generate(spec, width, height, image);
+
+	HQ2x hq2x;
+	HQ3x hq3x;
+	const HQx *scalers[] = { &hq2x, &hq3x };
+	const size_t first = results.size();
+
+	for (uint32_t threads = 1; threads <= options.threads; ++threads)
+	{
+		ThreadPool pool(threads);
+		char suffix[32];
+		snprintf(suffix, sizeof(suffix), "/t%u", threads);
+
+		BenchResult copy = bench_run(options, string("copy") + suffix, COPY_SIZE, [&]()
+		{
+			pool.run(threads, [&](uint32_t band)
+			{
+				size_t begin = COPY_SIZE * band / threads;
+				size_t end = COPY_SIZE * (band + 1) / threads;
+				std::copy(copySource.begin() + begin, copySource.begin() + end,
+					copyTarget.begin() + begin);
+			});
+			bench_sink = copyTarget[0];
+		});
+		copy.threads = threads;
+		copy.bandwidth = 2.0 * sizeof(uint32_t) / copy.median;
+		results.push_back(copy);
+
+		for (size_t i = 0; i < sizeof(scalers) / sizeof(HQx*); ++i)
+		{
+			const HQx &scale = *scalers[i];
+			char name[64];
+			snprintf(name, sizeof(name), "HQ%ux::resizeParallel/%s%s", scale.getFactor(),
+				spec.name, suffix);
+
+			BenchResult result = bench_run(options, name, pixels, [&]()
+			{
+				scale.resizeParallel(pool, image.data(), width, height, output.data());
+				bench_sink = output[0];
+			});
+			result.threads = threads;
+			result.bandwidth = (double) (scale.getFactor() * scale.getFactor() *
+				sizeof(uint32_t)) / result.median;
+			results.push_back(result);
+		}
+	}
+
+	// every thread count has the copy followed by one result per scaler
+	const size_t step = 1 + sizeof(scalers) / sizeof(HQx*);
+	printf("\n%-8s %-8s %10s %10s %12s %12s %10s\n", "scaler", "threads", "speedup",
+		"efficiency", "write GB/s", "copy GB/s", "of copy");
+	for (size_t i = 0; i < sizeof(scalers) / sizeof(HQx*); ++i)
+	{
+		const BenchResult &single = results[first + 1 + i];
+		uint32_t knee = 1;
+
+		for (uint32_t threads = 1; threads <= options.threads; ++threads)
+		{
+			const BenchResult &copy = results[first + (threads - 1) * step];
+			const BenchResult &result = results[first + (threads - 1) * step + 1 + i];
+			double speedup = single.median / result.median;
+			double efficiency = speedup / threads;
+			// the knee is the last thread count still scaling with 75% efficiency
+			if (efficiency >= 0.75) knee = threads;
+
+			printf("HQ%ux     %-8u %10.2f %9.0f%% %12.2f %12.2f %9.0f%%\n", scalers[i]->getFactor(),
+				threads, speedup, efficiency * 100, result.bandwidth, copy.bandwidth,
+				result.bandwidth / copy.bandwidth * 100);
+		}
+		printf("HQ%ux scales up to %u threads (knee point)\n", scalers[i]->getFactor(), knee);
+	}
+}
+
+
+/**
+ * @brief Replays a capture at a fixed frame rate and reports the latency of
+ * the frames.
+ *
+ * The latency of each frame is measured from the moment it should be
+ * available (its slot in the frame rate) to the end of the scaling, so a
+ * frame delayed by the previous one is also accounted. With a governor the
+ * frames which would exceed the budget are degraded instead.
+ */
+static int bench_replay(
+	const BenchOptions &options )
+{
+	// loads every frame before the replay to keep the disk out of the measurement
+	CaptureReader reader;
+	if (reader.open(options.replayFile) != 0)
+	{
+		std::cerr << "Unable to open the capture '" << options.replayFile << "'" << std::endl;
+		return 1;
+	}
+	uint32_t width = reader.getWidth();
+	uint32_t height = reader.getHeight();
+
+	std::vector< std::vector<uint32_t> > frames;
+	std::vector<uint32_t> frame;
+	int result;
+	while ((result = reader.read(frame)) == 0) frames.push_back(frame);
+	if (result < 0 || frames.empty())
+	{
+		std::cerr << "Invalid capture '" << options.replayFile << "'" << std::endl;
+		return 1;
+	}
+
+	HQx *scale;
+	if (options.factor == 3)
+		scale = new HQ3x();
+	else
+	if (options.factor == 4)
+		scale = new HQ4x();
+	else
+		scale = new HQ2x();
+	uint32_t factor = scale->getFactor();
+	ThreadPool *pool = (options.threads > 0) ? new ThreadPool(options.threads) : NULL;
+	std::vector<uint32_t> output((size_t) width * height * factor * factor);
+
+	for (uint32_t i = 0; i < options.warmup; ++i)
+		scale->resize(frames[i % frames.size()].data(), width, height, output.data());
+
+	double budget = 1000.0 / options.rate;
+	HQxGovernor governor(*scale, budget, pool);
+
+	std::chrono::nanoseconds period((int64_t) (1e9 / options.rate));
+	std::vector<double> latencies;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (uint32_t loop = 0; loop < options.loops; ++loop)
+		for (size_t i = 0; i < frames.size(); ++i)
+		{
+			std::chrono::steady_clock::time_point arrival = start + period * (int64_t) latencies.size();
+			std::this_thread::sleep_until(arrival);
+
+			if (options.governor)
+				governor.resize(frames[i].data(), width, height, output.data());
+			else
+			if (pool != NULL)
+				scale->resizeParallel(*pool, frames[i].data(), width, height, output.data());
+			else
+				scale->resize(frames[i].data(), width, height, output.data());
+
+			latencies.push_back(std::chrono::duration<double, std::milli>(
+				std::chrono::steady_clock::now() - arrival).count());
+		}
+
+	uint32_t degraded = (uint32_t) governor.getDegradedFrames();
+	delete pool;
+	delete scale;
+
+	double mean = 0, variance = 0;
+	uint32_t missed = 0;
+	for (size_t i = 0; i < latencies.size(); ++i)
+	{
+		mean += latencies[i];
+		if (latencies[i] > budget) ++missed;
+	}
+	mean /= (double) latencies.size();
+	for (size_t i = 0; i < latencies.size(); ++i)
+		variance += (latencies[i] - mean) * (latencies[i] - mean);
+	// the jitter is the standard deviation of the latency
+	double jitter = sqrt(variance / (double) latencies.size());
+
+	std::vector<double> sorted = latencies;
+	std::sort(sorted.begin(), sorted.end());
+	double p50 = bench_percentile(sorted, 50);
+	double p95 = bench_percentile(sorted, 95);
+	double p99 = bench_percentile(sorted, 99);
+	double maximum = sorted.back();
+
+	printf("Replayed %u frames [%ux%u] with HQ%ux at %.2f fps (%.3f ms per frame)\n",
+		(uint32_t) latencies.size(), width, height, factor, options.rate, budget);
+	printf("Latency (ms): p50 %.3f  p95 %.3f  p99 %.3f  max %.3f  mean %.3f  jitter %.3f\n",
+		p50, p95, p99, maximum, mean, jitter);
+	printf("Frames over budget: %u (%.2f%%)\n", missed, 100.0 * missed / (double) latencies.size());
+	if (options.governor)
+		printf("Degraded frames: %u (%.2f%%)\n", degraded,
+			100.0 * degraded / (double) latencies.size());
+
+	if (!options.jsonFile.empty())
+	{
+		std::ofstream json(options.jsonFile.c_str());
+		json << "{\n  \"capture\": \"" << options.replayFile << "\",\n  \"width\": " << width
+			<< ",\n  \"height\": " << height << ",\n  \"factor\": " << factor
+			<< ",\n  \"threads\": " << options.threads << ",\n  \"rate\": " << options.rate
+			<< ",\n  \"frames\": " << latencies.size() << ",\n  \"p50_ms\": " << p50
+			<< ",\n  \"p95_ms\": " << p95 << ",\n  \"p99_ms\": " << p99
+			<< ",\n  \"max_ms\": " << maximum << ",\n  \"mean_ms\": " << mean
+			<< ",\n  \"jitter_ms\": " << jitter << ",\n  \"missed\": " << missed
+			<< ",\n  \"governor\": " << (options.governor ? "true" : "false")
+			<< ",\n  \"degraded\": " << degraded << "\n}\n";
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief Parses a decimal number which must be in the range [minimum, maximum].
+ */
+static bool bench_parseNumber(
+	const char *text,
+	uint32_t minimum,
+	uint32_t maximum,
+	uint32_t &number )
+{
+	char *end;
+	errno = 0;
+	long long value = strtoll(text, &end, 10);
+	if (*text == 0 || *end != 0 || errno != 0 || value < minimum || value > maximum)
+		return false;
+	number = (uint32_t) value;
+	return true;
+}
+
+
+static void bench_usage()
+{
+	std::cerr << "Usage: hqx_bench [--size WxH|name] [--class name] [--warmup N] [--runs N] [--json file] [--perf]\n"
+		"       hqx_bench --scaling [--threads N] [--size WxH|name] [--class name] [--runs N] [--json file]\n"
+		"       hqx_bench --replay <capture> [--factor 2|3|4] [--rate fps] [--loops N] [--threads N] [--governor] [--json file]\n"
+		"       hqx_bench --generate <directory> [--size WxH|name] [--class name]" << std::endl;
+}
+
+
+int main( int argc, char **argv )
+{
+	BenchOptions options;
+	options.width = 320;
+	options.height = 240;
+	options.warmup = 3;
+	options.runs = 25;
+	options.perf = NULL;
+	options.scaling = false;
+	options.threads = 0;
+	options.factor = 2;
+	options.rate = 60;
+	options.loops = 1;
+	options.governor = false;
+	bool perf = false;
+	bool valid = true;
+
+	for (int i = 1; i < argc && valid; ++i)
+	{
+		if (strcmp(argv[i], "--size") == 0 && i + 1 < argc)
+		{
+			if (!Corpus::parseSize(argv[++i], options.width, options.height))
+			{
+				bench_usage();
+				return 1;
+			}
+		}
+		else
+		if (strcmp(argv[i], "--class") == 0 && i + 1 < argc)
+			options.className = argv[++i];
+		else
+		if (strcmp(argv[i], "--generate") == 0 && i + 1 < argc)
+			options.generateDir = argv[++i];
+		else
+		if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc)
+			valid = bench_parseNumber(argv[++i], 0, BENCH_MAX_COUNT, options.warmup);
+		else
+		if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc)
+			valid = bench_parseNumber(argv[++i], 1, BENCH_MAX_COUNT, options.runs);
+		else
+		if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+			options.jsonFile = argv[++i];
+		else
+		if (strcmp(argv[i], "--perf") == 0)
+			perf = true;
+		else
+		if (strcmp(argv[i], "--scaling") == 0)
+			options.scaling = true;
+		else
+		if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+			valid = bench_parseNumber(argv[++i], 0, BENCH_MAX_THREADS, options.threads);
+		else
+		if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+			options.replayFile = argv[++i];
+		else
+		if (strcmp(argv[i], "--factor") == 0 && i + 1 < argc)
+			valid = bench_parseNumber(argv[++i], 2, 4, options.factor);
+		else
+		if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc)
+			options.rate = atof(argv[++i]);
+		else
+		if (strcmp(argv[i], "--loops") == 0 && i + 1 < argc)
+			valid = bench_parseNumber(argv[++i], 1, BENCH_MAX_COUNT, options.loops);
+		else
+		if (strcmp(argv[i], "--governor") == 0)
+			options.governor = true;
+		else
+		{
+			bench_usage();
+			return 1;
+		}
+	}
+	if (!valid || options.width == 0 || options.height == 0 || options.rate <= 0)
+	{
+		bench_usage();
+		return 1;
+	}
+	if (options.scaling && options.threads == 0)
+		options.threads = std::max(1U, std::thread::hardware_concurrency());
+
+	if (!options.replayFile.empty())
+		return bench_replay(options);
+
+	const std::vector<CorpusSpec> &classes = Corpus::getClasses();
+	if (!options.generateDir.empty())
+		return bench_generate(options, classes);
+
+	PerfCounters counters;
+	if (perf)
+	{
+		if (counters.isAvailable())
+			options.perf = &counters;
+		else
+			std::cerr << "Hardware counters are unavailable: " << counters.getError() << std::endl;
+	}
+
+	printf("%-36s %12s %12s %12s %12s\n", "benchmark", "median ns/px", "p99 ns/px",
+		"min ns/px", "Mpix/s");
+
+	std::vector<BenchResult> results;
+	if (options.scaling)
+		bench_scaling(options, classes, results);
+	else
+	{
+		bench_components(options, classes, results);
+		bench_classes(options, classes, results);
+	}
+
+	if (!options.jsonFile.empty()) bench_writeJson(options, results);
+	return 0;
+}
@@ -16,10 +16,27 @@
 
 #include <hqx/HQ2x.hh>
 #include <hqx/HQ3x.hh>
+#include <hqx/HQ4x.hh>
+#include <hqx/ThreadPool.hh>
+#include "Bitmap.hh"
+#include "Capture.hh"
 #include <fstream>
+#include <cctype>
+#include <cerrno>
 #include <cstdlib>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <ctime>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <new>
+#include <set>
+#include <vector>
+#include <dirent.h>
+#include <sys/stat.h>
 
 
 using std::ifstream;
@@ -27,153 +44,668 @@ using std::ofstream;
 using std::string;
 
 
-#pragma pack(push, 1)
+// one in every MAIN_STATS_SAMPLING pixels has its interpolation cost measured
+static const uint32_t MAIN_STATS_SAMPLING = 64;
 
-struct BitmapHeader
+// limits of the values given in the command line and in the PAM headers
+static const uint32_t MAIN_MAX_THREADS = 1024;
+static const uint32_t MAIN_MAX_SIDE = 32768;
+
+
+/**
+ * @brief Returns a new scaler for the given factor (NULL if there is none).
+ */
+static HQx *main_createScaler(
+	uint32_t factor )
+{
+	switch (factor)
+	{
+		case 2: return new HQ2x();
+		case 3: return new HQ3x();
+		case 4: return new HQ4x();
+		default: return NULL;
+	}
+}
+
+
+static void main_usage()
+{
+	std::cerr << "Usage: hqx <image.bmp> [2|3|4]\n"
+		"       hqx --pipe [2|3|4] [threads]\n"
+		"       hqx --batch <directory or list> <output directory> [2|3|4] [threads]\n"
+		"       hqx --capture <file> [delta]\n"
+		"Every mode also accepts --stats <file>" << std::endl;
+}
+
+
+/**
+ * @brief Parses the scale factor given in the command line, which must be 2, 3 or 4.
+ */
+static bool main_parseFactor(
+	const char *text,
+	uint32_t &factor )
+{
+	char *end;
+	long value = strtol(text, &end, 10);
+	if (*text == 0 || *end != 0 || value < 2 || value > 4) return false;
+	factor = (uint32_t) value;
+	return true;
+}
+
+
+/**
+ * @brief Parses a decimal number which must be in the range [minimum, maximum].
+ */
+static bool main_parseNumber(
+	const char *text,
+	uint32_t minimum,
+	uint32_t maximum,
+	uint32_t &number )
+{
+	char *end;
+	errno = 0;
+	long long value = strtoll(text, &end, 10);
+	if (*text == 0 || *end != 0 || errno != 0 || value < minimum || value > maximum)
+		return false;
+	number = (uint32_t) value;
+	return true;
+}
+
+
+/**
+ * @brief Raw frame used by the pipe and batch modes.
+ */
+struct Frame
 {
-    uint16_t bfType;
-    uint32_t bfSize;
-    uint32_t bfRes1;
-    uint32_t bfOffBits;
+	string name;
+	uint32_t width;
+	uint32_t height;
+	uint32_t depth;
+	std::vector<uint32_t> pixels;
+	std::vector<uint32_t> output;
+	std::vector<uint8_t> buffer;
 };
 
-struct DibHeader
-{
-	uint32_t biSize;
-	uint32_t biWidth;
-	uint32_t biHeight;
-	uint16_t biPlanes;
-	uint16_t biBitCount;
-	uint32_t biCompression;
-	uint32_t biSizeImage;
-	uint32_t biXPelsPerMeter;
-	uint32_t biYPelsPerMeter;
-	uint32_t biClrUsed;
-	uint32_t biClrImportant;
+
+/**
+ * @brief Blocking queue used to pass frames between the pipeline stages.
+ */
+class FrameQueue
+{
+	public:
+		void push( Frame *frame )
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			frames.push_back(frame);
+			available.notify_one();
+		}
+
+		Frame *pop()
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			while (frames.empty()) available.wait(guard);
+			Frame *frame = frames.front();
+			frames.pop_front();
+			return frame;
+		}
+
+	private:
+		std::mutex lock;
+		std::condition_variable available;
+		std::deque<Frame*> frames;
 };
 
-#pragma pack(pop)
+
+/**
+ * @brief Reads the next token of a PAM header.
+ */
+static bool main_readPamToken(
+	FILE *input,
+	string &token )
+{
+	int c;
+
+	token.clear();
+	while ((c = fgetc(input)) != EOF)
+	{
+		if (c == '#')
+		{
+			while ((c = fgetc(input)) != EOF && c != '\n');
+			continue;
+		}
+		if (isspace(c))
+		{
+			if (token.empty()) continue;
+			break;
+		}
+		token += (char) c;
+	}
+
+	return !token.empty();
+}
+
+
+/**
+ * @brief Reads a PAM frame (RGB or RGB_ALPHA, 8 bits per sample).
+ *
+ * @return Zero if successful, 1 at the end of the stream or -1 on error.
+ */
+int main_readPam(
+	FILE *input,
+	Frame &frame )
+{
+	string token;
+	uint32_t maxValue = 255;
+
+	if (!main_readPamToken(input, token)) return 1;
+	if (token != "P7") return -1;
+
+	frame.width = frame.height = frame.depth = 0;
+	while (true)
+	{
+		if (!main_readPamToken(input, token)) return -1;
+		if (token == "ENDHDR") break;
+
+		string value;
+		if (token == "TUPLTYPE")
+		{
+			// the tuple type is implied by the depth
+			while ((value.empty() || value.back() != '\n') && !feof(input))
+				value += (char) fgetc(input);
+			continue;
+		}
+		if (!main_readPamToken(input, value)) return -1;
+		bool valid = true;
+		if (token == "WIDTH")
+			valid = main_parseNumber(value.c_str(), 1, MAIN_MAX_SIDE, frame.width);
+		else
+		if (token == "HEIGHT")
+			valid = main_parseNumber(value.c_str(), 1, MAIN_MAX_SIDE, frame.height);
+		else
+		if (token == "DEPTH")
+			valid = main_parseNumber(value.c_str(), 1, 4, frame.depth);
+		else
+		if (token == "MAXVAL")
+			valid = main_parseNumber(value.c_str(), 1, 65535, maxValue);
+		if (!valid) return -1;
+	}
+
+	if (frame.width == 0 || frame.height == 0 || maxValue != 255) return -1;
+	if (frame.depth != 3 && frame.depth != 4) return -1;
+
+	size_t pixels = (size_t) frame.width * frame.height;
+	frame.buffer.resize(pixels * frame.depth);
+	frame.pixels.resize(pixels);
+	if (fread(frame.buffer.data(), 1, frame.buffer.size(), input) != frame.buffer.size()) return -1;
+
+	const uint8_t *ptr = frame.buffer.data();
+	for (size_t i = 0; i < pixels; ++i, ptr += frame.depth)
+	{
+		uint32_t alpha = (frame.depth == 4) ? ptr[3] : 0xFF;
+		frame.pixels[i] = (alpha << 24) | (ptr[0] << 16) | (ptr[1] << 8) | ptr[2];
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief Writes the output of a frame as PAM using the depth of the input.
+ */
+int main_writePam(
+	FILE *output,
+	Frame &frame,
+	uint32_t factor )
+{
+	uint32_t width  = frame.width * factor;
+	uint32_t height = frame.height * factor;
+
+	fprintf(output, "P7\nWIDTH %u\nHEIGHT %u\nDEPTH %u\nMAXVAL 255\nTUPLTYPE %s\nENDHDR\n",
+		width, height, frame.depth, (frame.depth == 4) ? "RGB_ALPHA" : "RGB");
+
+	size_t pixels = (size_t) width * height;
+	frame.buffer.resize(pixels * frame.depth);
+	uint8_t *ptr = frame.buffer.data();
+	for (size_t i = 0; i < pixels; ++i, ptr += frame.depth)
+	{
+		uint32_t value = frame.output[i];
+		ptr[0] = (uint8_t) (value >> 16);
+		ptr[1] = (uint8_t) (value >> 8);
+		ptr[2] = (uint8_t) value;
+		if (frame.depth == 4) ptr[3] = (uint8_t) (value >> 24);
+	}
+
+	if (fwrite(frame.buffer.data(), 1, frame.buffer.size(), output) != frame.buffer.size()) return -1;
+	return fflush(output) == 0 ? 0 : -1;
+}
 
 
 /**
- * @brief Saves an Windows Bitmap image (24 BPP).
+ * @brief Saves the pattern statistics of the scaler as JSON.
  */
-int main_saveBitmap(
-	const uint32_t *data,
-	uint32_t width,
-	uint32_t height,
+int main_saveStats(
+	const HQx &scale,
 	const string &fileName )
 {
-	BitmapHeader bh;
-	DibHeader dh;
-	uint16_t suffix;
-	uint32_t zero = 0;
-	const uint32_t *ptr;
+	if (fileName.empty()) return 0;
+
+	HQxStats stats;
+	bool enabled = scale.getStats(stats);
+	uint64_t pixels = 0, checks = 0;
+	for (int i = 0; i < 256; ++i)
+	{
+		pixels += stats.hits[i];
+		checks += stats.checks[i];
+	}
 
-	ofstream output(fileName.c_str(), std::ios_base::binary);
+	ofstream output(fileName.c_str());
 	if (!output.good()) return -1;
 
-	suffix = ((width + 3) & ~0x03) - width;
+	output << "{\n  \"factor\": " << scale.getFactor() << ",\n  \"enabled\": "
+		<< (enabled ? "true" : "false") << ",\n  \"pixels\": " << pixels
+		<< ",\n  \"checks\": " << checks << ",\n  \"patterns\": [";
+	bool first = true;
+	for (int i = 0; i < 256; ++i)
+	{
+		if (stats.hits[i] == 0) continue;
+		output << (first ? "\n" : ",\n") << "    { \"pattern\": " << i << ", \"hits\": "
+			<< stats.hits[i] << ", \"share\": " << (double) stats.hits[i] / (double) pixels
+			<< ", \"checks\": " << stats.checks[i] << ", \"samples\": " << stats.samples[i];
+		if (stats.samples[i] > 0)
+			output << ", \"cycles\": " << (double) stats.cycles[i] / (double) stats.samples[i];
+		output << " }";
+		first = false;
+	}
+	output << "\n  ]\n}\n";
+
+	if (!enabled) std::cerr << "The library was built without statistics (HQX_ENABLE_STATS)" << std::endl;
+	return 0;
+}
 
-	dh.biSize          = sizeof(DibHeader);
-	dh.biWidth         = width;
-	dh.biHeight        = height;
-	dh.biPlanes        = 1;
-	dh.biBitCount      = 24;
-	dh.biCompression   = 0;
-	dh.biSizeImage     = (uint16_t) ( (width*3+suffix)*height );
-	dh.biXPelsPerMeter = 0x2E23;
-	dh.biYPelsPerMeter = dh.biXPelsPerMeter;
-	dh.biClrUsed       = 0;
-	dh.biClrImportant  = 0;
 
-	bh.bfType    = 0x4D42;
-	bh.bfSize    = dh.biSizeImage + 0x0036;
-	bh.bfRes1    = 0;
-	bh.bfOffBits = 0x0036;
-	output.write( (char*) &bh, sizeof(BitmapHeader) );
-	output.write( (char*) &dh, sizeof(DibHeader) );
+/**
+ * @brief Runs the read, scale and write stages in different threads.
+ *
+ * The frames circulate between the stages, so the next frame is read and the
+ * previous one is written while the current one is being scaled by the pool.
+ * The stage functions return zero if successful, 1 at the end of the input or
+ * -1 on error.
+ *
+ * @return Number of scaled frames.
+ */
+template<typename R, typename W>
+uint32_t main_runPipeline(
+	ThreadPool &pool,
+	const HQx &scale,
+	R read,
+	W write,
+	int &readResult,
+	int &writeResult )
+{
+	uint32_t factor = scale.getFactor();
+	Frame frames[3];
+	FrameQueue freeFrames, readFrames, scaledFrames;
+	for (size_t i = 0; i < sizeof(frames) / sizeof(Frame); ++i)
+		freeFrames.push(frames + i);
 
-	ptr = data + (width * height);
-	for (uint32_t i = 0; i < height; i++)
+	readResult = writeResult = 0;
+
+	std::thread reader([&]()
 	{
-		ptr -= width;
+		while (true)
+		{
+			Frame *frame = freeFrames.pop();
+			readResult = read(*frame);
+			if (readResult != 0) break;
+			readFrames.push(frame);
+		}
+		readFrames.push(NULL);
+	});
 
-		for (uint32_t j = 0; j < width; ++j)
-			output.write( (char*) (ptr + j), 3 );
+	std::thread writer([&]()
+	{
+		Frame *frame;
+		while ((frame = scaledFrames.pop()) != NULL)
+		{
+			if (writeResult == 0) writeResult = write(*frame);
+			freeFrames.push(frame);
+		}
+	});
 
-		if (suffix > 0)
-			output.write( (char*) &zero, suffix );
+	uint32_t count = 0;
+	Frame *frame;
+	while ((frame = readFrames.pop()) != NULL)
+	{
+		frame->output.resize((size_t) frame->width * factor * frame->height * factor);
+		scale.resizeParallel(pool, frame->pixels.data(), frame->width, frame->height,
+			frame->output.data());
+		scaledFrames.push(frame);
+		++count;
 	}
+	scaledFrames.push(NULL);
+
+	reader.join();
+	writer.join();
+	return count;
+}
 
-  output.close();
 
-  return 0;
+/**
+ * @brief Scales a stream of PAM frames from the standard input to the standard output.
+ */
+int main_pipe(
+	uint32_t factor,
+	uint32_t threads,
+	const string &statsFile )
+{
+	ThreadPool pool(threads);
+	HQx *scale = main_createScaler(factor);
+	factor = scale->getFactor();
+	if (!statsFile.empty()) scale->setStatsSampling(MAIN_STATS_SAMPLING);
+
+	int readResult, writeResult;
+	uint32_t count = main_runPipeline(pool, *scale,
+		[&](Frame &frame) { return main_readPam(stdin, frame); },
+		[&](Frame &frame) { return main_writePam(stdout, frame, factor); },
+		readResult, writeResult);
+	main_saveStats(*scale, statsFile);
+	delete scale;
+
+	std::cerr << "Scaled " << count << " frames by " << factor << 'x' << std::endl;
+	if (readResult < 0) std::cerr << "Invalid input frame" << std::endl;
+	if (writeResult < 0) std::cerr << "Unable to write output frame" << std::endl;
+	return (readResult < 0 || writeResult < 0) ? 1 : 0;
 }
 
 
 /**
- * @brief Loads an Windows Bitmap image (24 BPP).
+ * @brief Records the PAM frames from the standard input in a capture file,
+ * which can be replayed by the benchmark.
  */
-int main_loadBitmap(
+int main_capture(
 	const string &fileName,
-	uint32_t *&data,
-	uint16_t &width,
-	uint16_t &height )
+	bool delta )
 {
-	BitmapHeader bh;
-	DibHeader dh;
-	uint16_t  suffix;
-	uint32_t zero = 0;
-	uint32_t *ptr;
-	uint16_t bits;
+	CaptureWriter writer;
+	Frame frame;
+	uint32_t count = 0, width = 0, height = 0;
+	int result;
+
+	while ((result = main_readPam(stdin, frame)) == 0)
+	{
+		if (count == 0)
+		{
+			width = frame.width;
+			height = frame.height;
+			if (writer.open(fileName, width, height, delta) != 0)
+			{
+				std::cerr << "Unable to create '" << fileName << "'" << std::endl;
+				return 1;
+			}
+		}
+		if (frame.width != width || frame.height != height)
+		{
+			std::cerr << "All frames must have the same size" << std::endl;
+			return 1;
+		}
+		if (writer.write(frame.pixels.data()) != 0)
+		{
+			std::cerr << "Unable to write '" << fileName << "'" << std::endl;
+			return 1;
+		}
+		++count;
+	}
+	if (writer.close() != 0)
+	{
+		std::cerr << "Unable to write '" << fileName << "'" << std::endl;
+		return 1;
+	}
 
-	ifstream input(fileName.c_str(), std::ios_base::binary);
-	if (!input.good()) return -1;
+	std::cerr << "Captured " << count << " frames" << std::endl;
+	if (result < 0) std::cerr << "Invalid input frame" << std::endl;
+	return (result < 0) ? 1 : 0;
+}
 
-	input.read( (char*) &bh, sizeof(BitmapHeader) );
-	if (bh.bfType != 0x4D42) return -1;
-	input.read( (char*) &dh.biSize, sizeof(uint32_t) );
-	if (dh.biSize != 40) return -1;
 
-	input.read( (char*) &dh.biWidth, sizeof(DibHeader) - sizeof(uint32_t) );
-	width  = dh.biWidth;
-	height = dh.biHeight;
-	if (dh.biBitCount != 24) return -1;
+/**
+ * @brief Lists the bitmaps of a directory or the files in a list file (one per line).
+ */
+int main_listFiles(
+	const string &source,
+	std::vector<string> &files )
+{
+	struct stat info;
+	if (stat(source.c_str(), &info) != 0) return -1;
 
-	suffix = ((width + 3) & ~0x03) - width;
-	ptr = data = new uint32_t[width * height]();
-	ptr += width * height;
-	for (uint32_t i = 0; i < height; i++)
+	if (S_ISDIR(info.st_mode))
 	{
-		ptr -= width;
+		DIR *dir = opendir(source.c_str());
+		if (dir == NULL) return -1;
 
-		for (uint32_t j = 0; j < width; ++j)
+		struct dirent *entry;
+		while ((entry = readdir(dir)) != NULL)
 		{
-			input.read( (char*) (ptr + j), 3 );
-			*(ptr + j) |= 0xFF000000;
+			string name = entry->d_name;
+			if (name.size() < 4) continue;
+			string extension = name.substr(name.size() - 4);
+			for (size_t i = 0; i < extension.size(); ++i)
+				extension[i] = (char) tolower(extension[i]);
+			if (extension == ".bmp") files.push_back(source + "/" + name);
 		}
+		closedir(dir);
+		std::sort(files.begin(), files.end());
+	}
+	else
+	{
+		ifstream input(source.c_str());
+		if (!input.good()) return -1;
 
-		if (suffix > 0)
-			input.read( (char*) &zero, suffix );
+		string line;
+		while (std::getline(input, line))
+		{
+			while (!line.empty() && isspace(line[line.size() - 1])) line.erase(line.size() - 1);
+			if (!line.empty()) files.push_back(line);
+		}
 	}
 
-	input.close();
 	return 0;
 }
 
 
+/**
+ * @brief Returns the path of the output file in the output directory.
+ */
+string main_outputName(
+	const string &outputDir,
+	const string &fileName )
+{
+	size_t slash = fileName.find_last_of('/');
+	if (slash == string::npos) return outputDir + "/" + fileName;
+	return outputDir + "/" + fileName.substr(slash + 1);
+}
+
+
+/**
+ * @brief Scales a set of bitmaps and saves the results in the output directory.
+ *
+ * Small files are distributed between the threads, each one running its own
+ * load, scale and save sequence. Files bigger than BATCH_LARGE_FILE are then
+ * processed one at a time by the pipeline, with every image split in bands.
+ */
+int main_batch(
+	const string &source,
+	const string &outputDir,
+	uint32_t factor,
+	uint32_t threads,
+	const string &statsFile )
+{
+	static const off_t BATCH_LARGE_FILE = 8 * 1024 * 1024;
+
+	std::vector<string> files, small, large;
+	if (main_listFiles(source, files) != 0)
+	{
+		std::cerr << "Unable to list the files in '" << source << "'" << std::endl;
+		return 1;
+	}
+	struct stat info;
+	if ((mkdir(outputDir.c_str(), 0755) != 0 && errno != EEXIST) ||
+		stat(outputDir.c_str(), &info) != 0 || !S_ISDIR(info.st_mode))
+	{
+		std::cerr << "Unable to create the output directory '" << outputDir << "'" << std::endl;
+		return 1;
+	}
+
+	// only the base name is kept, so files with the same one would be saved in
+	// the same output file at the same time
+	std::set<string> outputs;
+	uint32_t duplicated = 0;
+	for (size_t i = 0; i < files.size(); ++i)
+	{
+		if (!outputs.insert(main_outputName(outputDir, files[i])).second)
+		{
+			std::cerr << "Skipping '" << files[i] << "', whose output name is used by another file"
+				<< std::endl;
+			++duplicated;
+			continue;
+		}
+		if (stat(files[i].c_str(), &info) == 0 && info.st_size > BATCH_LARGE_FILE)
+			large.push_back(files[i]);
+		else
+			small.push_back(files[i]);
+	}
+
+	ThreadPool pool(threads);
+	HQx *scale = main_createScaler(factor);
+	factor = scale->getFactor();
+	if (!statsFile.empty()) scale->setStatsSampling(MAIN_STATS_SAMPLING);
+
+	std::atomic<uint64_t> pixels(0);
+	std::atomic<uint32_t> failed(duplicated);
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	pool.run((uint32_t) small.size(), [&](uint32_t index)
+	{
+		Frame frame;
+		frame.name = small[index];
+		if (Bitmap::load(frame.name, frame.pixels, frame.width, frame.height) != 0)
+		{
+			++failed;
+			return;
+		}
+		try
+		{
+			frame.output.resize((size_t) frame.width * factor * frame.height * factor);
+		}
+		catch (const std::bad_alloc &)
+		{
+			++failed;
+			return;
+		}
+		scale->resize(frame.pixels.data(), frame.width, frame.height, frame.output.data());
+		if (Bitmap::save(frame.output.data(), frame.width * factor, frame.height * factor,
+			main_outputName(outputDir, frame.name)) != 0)
+		{
+			++failed;
+			return;
+		}
+		pixels += (uint64_t) frame.width * frame.height;
+	});
+
+	size_t next = 0;
+	int readResult, writeResult;
+	main_runPipeline(pool, *scale,
+		[&](Frame &frame)
+		{
+			for (; next < large.size(); ++next)
+			{
+				frame.name = large[next];
+				if (Bitmap::load(frame.name, frame.pixels, frame.width, frame.height) == 0)
+				{
+					++next;
+					return 0;
+				}
+				++failed;
+			}
+			return 1;
+		},
+		[&](Frame &frame)
+		{
+			if (Bitmap::save(frame.output.data(), frame.width * factor, frame.height * factor,
+				main_outputName(outputDir, frame.name)) != 0)
+				++failed;
+			else
+				pixels += (uint64_t) frame.width * frame.height;
+			return 0;
+		},
+		readResult, writeResult);
+	main_saveStats(*scale, statsFile);
+	delete scale;
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	if (seconds <= 0) seconds = 1e-9;
+	uint32_t processed = (uint32_t) files.size() - failed;
+	std::cout << "Processed " << processed << " files (" << failed << " failed) in " << seconds
+		<< " s: " << processed / seconds << " files/s, " << (double) pixels / 1e6 / seconds
+		<< " Mpix/s" << std::endl;
+
+	return (failed > 0) ? 1 : 0;
+}
+
+
 int main(int argc, char **argv )
 {
 	uint32_t factor = 2;
+	string statsFile;
 
-	if (argc != 2 && argc != 3) return 1;
-	if (argc == 3) factor = atoi(argv[2]);
+	// removes the options which are valid in every mode
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--stats") == 0 && i + 1 < argc)
+		{
+			statsFile = argv[i + 1];
+			for (int j = i + 2; j < argc; ++j) argv[j - 2] = argv[j];
+			argc -= 2;
+			break;
+		}
+	}
+
+	if (argc >= 2 && strcmp(argv[1], "--pipe") == 0)
+	{
+		uint32_t threads = 0;
+		if ((argc > 2 && !main_parseFactor(argv[2], factor)) ||
+			(argc > 3 && !main_parseNumber(argv[3], 0, MAIN_MAX_THREADS, threads)))
+		{
+			main_usage();
+			return 1;
+		}
+		return main_pipe(factor, threads, statsFile);
+	}
+
+	if (argc >= 3 && strcmp(argv[1], "--capture") == 0)
+		return main_capture(argv[2], argc > 3 && strcmp(argv[3], "delta") == 0);
+
+	if (argc >= 4 && strcmp(argv[1], "--batch") == 0)
+	{
+		uint32_t threads = 0;
+		if ((argc > 4 && !main_parseFactor(argv[4], factor)) ||
+			(argc > 5 && !main_parseNumber(argv[5], 0, MAIN_MAX_THREADS, threads)))
+		{
+			main_usage();
+			return 1;
+		}
+		return main_batch(argv[2], argv[3], factor, threads, statsFile);
+	}
+
+	if ((argc != 2 && argc != 3) || (argc == 3 && !main_parseFactor(argv[2], factor)))
+	{
+		main_usage();
+		return 1;
+	}
 
 	// loads the input image
-	uint16_t width, height;
-	uint32_t *image = NULL;
-	if ( main_loadBitmap(argv[1], image, width, height) != 0) return 1;
+	uint32_t width, height;
+	std::vector<uint32_t> image;
+	if ( Bitmap::load(argv[1], image, width, height) != 0) return 1;
 	std::cout << "Resizing '" << argv[1] << "' [" << width << "x" << height << "] by " <<
 		factor << 'x' << std::endl;
 
@@ -182,20 +714,17 @@ int main(int argc, char **argv )
 	// resize the input image using the given scale factor
 	uint32_t outputSize = (width * factor) * (height * factor);
 	uint32_t *output = new uint32_t[outputSize]();
-	HQx *scale;
-	if (factor == 2)
-		scale = new HQ2x();
-	else
-		scale = new HQ3x();
-	scale->resize(image, width, height, output);
+	HQx *scale = main_createScaler(factor);
+	if (!statsFile.empty()) scale->setStatsSampling(MAIN_STATS_SAMPLING);
+	scale->resize(image.data(), width, height, output);
+	main_saveStats(*scale, statsFile);
 	delete scale;
 
 	t = clock() - t;
 	std::cout << "Processing time: " << t / (CLOCKS_PER_SEC / 1000) << " ms" << std::endl;
 
 	// saves the resized image
-	if ( main_saveBitmap(output, width * factor, height * factor, "output.bmp") != 0 ) return 1;
+	if ( Bitmap::save(output, width * factor, height * factor, "output.bmp") != 0 ) return 1;
 
-	delete[] image;
 	delete[] output;
 }
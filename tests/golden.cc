@@ -0,0 +1,1275 @@
+/*
+ * Copyright 2016 Bruno Ribeiro
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Golden image regression test.
+ *
+ * Every image (the samples and the synthetic corpus) is scaled by every
+ * algorithm with every wrap mode and threshold preset. The output is split in
+ * blocks (produced by TILE_SIZE x TILE_SIZE source pixels) and the checksum of
+ * each block is compared with the golden checksums recorded from the reference
+ * implementation. Every variant of the same algorithm (single call, bands,
+ * thread pools, multiple algorithms in one pass, memoized blocks) must produce
+ * exactly the same output, also when it is rotated or mirrored while written.
+ * Filtering the output blocks while written must be the same as filtering the
+ * output later. The outputs of the reference implementations in the samples
+ * directory (listed in REFERENCES) are compared pixel by pixel, when present.
+ *
+ * Each feature is checked by its own function (listed in GOLDEN_TESTS), which
+ * records or compares its checksums with golden_record and golden_compare and
+ * reports the outputs which must be equal with golden_expect. The failures
+ * name the feature, the key and the variant.
+ *
+ * Usage: hqx_golden <samples directory> <golden file> [--record]
+ */
+
+#include <hqx/HQ2x.hh>
+#include <hqx/HQ3x.hh>
+#include <hqx/HQ4x.hh>
+#include <hqx/HQxFilter.hh>
+#include <hqx/HQxGovernor.hh>
+#include <hqx/HQxMap.hh>
+#include <hqx/HQxProgressive.hh>
+#include <hqx/HQxTileCache.hh>
+#include <hqx/Scale2x.hh>
+#include <hqx/Scale3x.hh>
+#include <hqx/ThreadPool.hh>
+#include "Bitmap.hh"
+#include "Corpus.hh"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+using std::string;
+
+
+static const uint32_t TILE_SIZE = 64;
+
+// size of the synthetic images (odd, to exercise partial tiles)
+static const uint32_t CORPUS_WIDTH = 97;
+static const uint32_t CORPUS_HEIGHT = 61;
+
+
+// output sizes of the resampling test, relative to the source in 1/4 units
+static const uint32_t RESAMPLE_SIZES[][2] =
+{
+	{ 10, 7 },
+	{ 5, 13 },
+	{ 3, 2 },
+};
+
+
+struct Preset
+{
+	const char *name;
+	uint32_t trY;
+	uint32_t trU;
+	uint32_t trV;
+	uint32_t trA;
+};
+
+
+static const Preset PRESETS[] =
+{
+	{ "default", 0x30, 0x07, 0x06, 0x50 },
+	{ "strict",  0x10, 0x03, 0x03, 0x20 },
+	{ "loose",   0x60, 0x10, 0x10, 0x80 },
+};
+
+
+struct Reference
+{
+	const char *source;
+	const char *output;
+	/// Index of the scaler in Golden::scalers
+	size_t scaler;
+};
+
+
+// outputs of the reference implementations, compared when found in the samples directory
+static const Reference REFERENCES[] =
+{
+	{ "test-image.bmp", "test-image-hq2x.bmp", 0 },
+	{ "test-image.bmp", "test-image-hq4x.bmp", 2 },
+};
+
+
+struct Image
+{
+	string name;
+	uint32_t width;
+	uint32_t height;
+	std::vector<uint32_t> pixels;
+};
+
+
+/**
+ * @brief State shared by the tests of every feature.
+ */
+struct Golden
+{
+	/// Whether the checksums are recorded instead of compared
+	bool record;
+	string samplesDir;
+	std::ofstream recorded;
+	/// Checksums loaded from the golden file
+	std::map< string, std::vector<uint32_t> > checksums;
+	std::vector<Image> images;
+	HQ2x hq2x;
+	HQ3x hq3x;
+	HQ4x hq4x;
+	std::vector<HQx*> scalers;
+	/// Name of each scaler in the keys
+	std::vector<const char*> names;
+	ThreadPool pool1;
+	ThreadPool pool2;
+	ThreadPool pool4;
+	/// Name of the feature being tested
+	const char *feature;
+	uint32_t cases;
+	uint32_t failures;
+
+	Golden() : record(false), pool1(1), pool2(2), pool4(4), feature(""), cases(0), failures(0)
+	{
+		scalers.push_back(&hq2x);
+		scalers.push_back(&hq3x);
+		scalers.push_back(&hq4x);
+		names.push_back("hq2x");
+		names.push_back("hq3x");
+		names.push_back("hq4x");
+	}
+};
+
+
+/**
+ * @brief Computes the FNV-1a checksum of every output block.
+ */
+static std::vector<uint32_t> golden_checksums(
+	const std::vector<uint32_t> &output,
+	uint32_t width,
+	uint32_t height,
+	uint32_t factor )
+{
+	uint32_t tile = TILE_SIZE * factor;
+	uint32_t outputWidth = width * factor;
+	uint32_t outputHeight = height * factor;
+	std::vector<uint32_t> checksums;
+
+	for (uint32_t ty = 0; ty < outputHeight; ty += tile)
+		for (uint32_t tx = 0; tx < outputWidth; tx += tile)
+		{
+			uint32_t hash = 2166136261U;
+			for (uint32_t y = ty; y < ty + tile && y < outputHeight; ++y)
+				for (uint32_t x = tx; x < tx + tile && x < outputWidth; ++x)
+				{
+					uint32_t value = output[(size_t) y * outputWidth + x];
+					for (int i = 0; i < 4; ++i, value >>= 8)
+					{
+						hash ^= value & 0xFF;
+						hash *= 16777619U;
+					}
+				}
+			checksums.push_back(hash);
+		}
+
+	return checksums;
+}
+
+
+/**
+ * @brief Returns the key of an output: image/algorithm/mode/preset.
+ */
+static string golden_key(
+	const Image &image,
+	const char *algorithm,
+	const string &mode,
+	const char *preset = "default" )
+{
+	char key[256];
+	snprintf(key, sizeof(key), "%s/%s/%s/%s", image.name.c_str(), algorithm, mode.c_str(),
+		preset);
+	return key;
+}
+
+
+static const char *golden_wrapName(
+	int wrap )
+{
+	return (wrap == 0) ? "clamp" : (wrap == 1) ? "wrapX" : (wrap == 2) ? "wrapY" : "wrapXY";
+}
+
+
+/**
+ * @brief Writes the checksums of an output in the golden file, if recording.
+ * Returns whether they were recorded, in which case the caller skips the checks.
+ */
+static bool golden_record(
+	Golden &golden,
+	const string &key,
+	const std::vector<uint32_t> &checksums )
+{
+	if (!golden.record) return false;
+
+	golden.recorded << key;
+	for (size_t j = 0; j < checksums.size(); ++j)
+	{
+		char value[16];
+		snprintf(value, sizeof(value), " %08x", checksums[j]);
+		golden.recorded << value;
+	}
+	golden.recorded << '\n';
+	return true;
+}
+
+
+/**
+ * @brief Counts one case which fails if @c passed is false.
+ */
+static void golden_expect(
+	Golden &golden,
+	const string &key,
+	const string &variant,
+	bool passed,
+	const char *reason = "output differs" )
+{
+	++golden.cases;
+	if (passed) return;
+
+	std::cerr << "FAIL " << golden.feature << ": " << key << " [" << variant << "]: " << reason
+		<< std::endl;
+	++golden.failures;
+}
+
+
+/**
+ * @brief Compares the checksums of an output (of an image with the given
+ * source width) with the golden ones, reporting the first differing block.
+ */
+static void golden_compare(
+	Golden &golden,
+	const string &key,
+	const string &variant,
+	const std::vector<uint32_t> &checksums,
+	uint32_t width,
+	uint32_t factor )
+{
+	std::map< string, std::vector<uint32_t> >::const_iterator it = golden.checksums.find(key);
+	if (it == golden.checksums.end())
+	{
+		golden_expect(golden, key, variant, false, "no golden checksums");
+		return;
+	}
+	if (checksums.size() != it->second.size())
+	{
+		golden_expect(golden, key, variant, false, "wrong number of blocks");
+		return;
+	}
+
+	for (size_t j = 0; j < checksums.size(); ++j)
+	{
+		if (checksums[j] == it->second[j]) continue;
+
+		uint32_t tiles = (width + TILE_SIZE - 1) / TILE_SIZE;
+		uint32_t x = (uint32_t) (j % tiles) * TILE_SIZE * factor;
+		uint32_t y = (uint32_t) (j / tiles) * TILE_SIZE * factor;
+		std::ostringstream reason;
+		reason << "first differing block is #" << j << " at output (" << x << ", " << y <<
+			") with size " << TILE_SIZE * factor << "x" << TILE_SIZE * factor;
+		golden_expect(golden, key, variant, false, reason.str().c_str());
+		return;
+	}
+	golden_expect(golden, key, variant, true);
+}
+
+
+/**
+ * @brief Undoes the transform of an output with the given size (before the
+ * transform).
+ */
+static std::vector<uint32_t> golden_untransform(
+	const std::vector<uint32_t> &output,
+	uint32_t width,
+	uint32_t height,
+	HQxTransform transform )
+{
+	std::vector<uint32_t> result(output.size());
+
+	for (uint32_t y = 0; y < height; ++y)
+		for (uint32_t x = 0; x < width; ++x)
+		{
+			size_t index;
+			switch (transform)
+			{
+				case HQX_ROTATE_90:  index = (size_t) x * height + (height - 1 - y); break;
+				case HQX_ROTATE_180: index = (size_t) (height - 1 - y) * width + (width - 1 - x); break;
+				case HQX_ROTATE_270: index = (size_t) (width - 1 - x) * height + y; break;
+				case HQX_FLIP_H:     index = (size_t) y * width + (width - 1 - x); break;
+				case HQX_FLIP_V:     index = (size_t) (height - 1 - y) * width + x; break;
+				default:             index = (size_t) y * width + x;
+			}
+			result[(size_t) y * width + x] = output[index];
+		}
+
+	return result;
+}
+
+
+/**
+ * @brief Returns the nearest-neighbor scaling of an image.
+ */
+static std::vector<uint32_t> golden_nearest(
+	const Image &image,
+	uint32_t factor )
+{
+	uint32_t width = image.width * factor;
+	uint32_t height = image.height * factor;
+	std::vector<uint32_t> output((size_t) width * height);
+	for (uint32_t y = 0; y < height; ++y)
+		for (uint32_t x = 0; x < width; ++x)
+			output[(size_t) y * width + x] = image.pixels[(size_t) (y / factor) * image.width +
+				x / factor];
+	return output;
+}
+
+
+/**
+ * @brief Every algorithm with every wrap mode and threshold preset, and every
+ * variant of running it.
+ */
+static void golden_testScalers(
+	Golden &golden )
+{
+	// sepia, scanlines and gamma
+	static const float SEPIA[12] = { 0.393f, 0.769f, 0.189f, 0, 0.349f, 0.686f, 0.168f, 0,
+		0.272f, 0.534f, 0.131f, 0 };
+	HQxPostProcess filter;
+	filter.addColorMatrix(SEPIA);
+	filter.addScanlines(0.4f, 3);
+	filter.addGamma(1.2f);
+	ThreadPool *pools[] = { &golden.pool1, &golden.pool2, &golden.pool4 };
+
+	for (size_t i = 0; i < golden.images.size(); ++i)
+	for (size_t s = 0; s < golden.scalers.size(); ++s)
+	for (int wrap = 0; wrap < 4; ++wrap)
+	for (size_t p = 0; p < sizeof(PRESETS) / sizeof(Preset); ++p)
+	{
+		const Image &image = golden.images[i];
+		HQx &scale = *golden.scalers[s];
+		const Preset &preset = PRESETS[p];
+		bool wrapX = (wrap & 1) != 0;
+		bool wrapY = (wrap & 2) != 0;
+		uint32_t factor = scale.getFactor();
+		uint32_t width = image.width;
+		uint32_t height = image.height;
+		string key = golden_key(image, golden.names[s], golden_wrapName(wrap), preset.name);
+
+		std::vector<uint32_t> output((size_t) width * height * factor * factor);
+		scale.resize(image.pixels.data(), width, height, output.data(), preset.trY, preset.trU,
+			preset.trV, preset.trA, wrapX, wrapY);
+		if (golden_record(golden, key, golden_checksums(output, width, height, factor))) continue;
+
+		// every variant must match the golden checksums
+		const std::vector<uint32_t> plain = output;
+		for (int variant = 0; variant < 15; ++variant)
+		{
+			if (variant == 12 || variant == 14)
+			{
+				// filtered while written must be the same as filtering the output
+				std::fill(output.begin(), output.end(), 0);
+				scale.setFilter(&filter);
+				scale.setMemoization(variant == 14);
+				scale.resizeParallel(golden.pool2, image.pixels.data(), width, height, output.data(),
+					preset.trY, preset.trU, preset.trV, preset.trA, wrapX, wrapY);
+				scale.setMemoization(false);
+				scale.setFilter(NULL);
+
+				std::vector<uint32_t> expected = plain;
+				for (uint32_t y = 0; y < height * factor; ++y)
+					filter.apply(expected.data() + (size_t) y * width * factor, width * factor, 0, y);
+				golden_expect(golden, key, (variant == 14) ? "resizeParallel/filter/memo" :
+					"resizeParallel/filter", output == expected);
+				continue;
+			}
+
+			string name = "resize";
+			if (variant == 1)
+			{
+				// uneven bands processed out of order
+				name = "resizeRows";
+				std::fill(output.begin(), output.end(), 0);
+				uint32_t middle = height / 3, last = height - height / 5;
+				scale.resizeRows(image.pixels.data(), width, height, output.data(), last, height,
+					preset.trY, preset.trU, preset.trV, preset.trA, wrapX, wrapY);
+				scale.resizeRows(image.pixels.data(), width, height, output.data(), 0, middle,
+					preset.trY, preset.trU, preset.trV, preset.trA, wrapX, wrapY);
+				scale.resizeRows(image.pixels.data(), width, height, output.data(), middle, last,
+					preset.trY, preset.trU, preset.trV, preset.trA, wrapX, wrapY);
+			}
+			else
+			if (variant == 5)
+			{
+				// every algorithm at once, with the output of this one in the middle
+				name = "resizeMultiple";
+				std::fill(output.begin(), output.end(), 0);
+				std::vector<uint32_t> other2((size_t) width * height * 4);
+				std::vector<uint32_t> other3((size_t) width * height * 9);
+				const HQx *multiple[] = { &golden.hq3x, &scale, &golden.hq2x };
+				uint32_t *outputs[] = { other3.data(), output.data(), other2.data() };
+				HQx::resizeMultiple(multiple, 3, image.pixels.data(), width, height, outputs,
+					preset.trY, preset.trU, preset.trV, preset.trA, wrapX, wrapY, &golden.pool4);
+			}
+			else
+			if (variant == 6)
+			{
+				// resampling to the size of the scaled image must not change it
+				name = "resizeTo";
+				std::fill(output.begin(), output.end(), 0);
+				scale.resizeTo(image.pixels.data(), width, height, output.data(), width * factor,
+					height * factor, preset.trY, preset.trU, preset.trV, preset.trA, wrapX, wrapY,
+					&golden.pool4);
+			}
+			else
+			if (variant == 13)
+			{
+				// the output blocks of repeated windows copied from the cache
+				name = "resizeMultiple/memo";
+				std::fill(output.begin(), output.end(), 0);
+				std::vector<uint32_t> other2((size_t) width * height * 4);
+				const HQx *multiple[] = { &scale, &golden.hq2x };
+				uint32_t *outputs[] = { output.data(), other2.data() };
+				scale.setMemoization(true);
+				HQx::resizeMultiple(multiple, 2, image.pixels.data(), width, height, outputs,
+					preset.trY, preset.trU, preset.trV, preset.trA, wrapX, wrapY, &golden.pool2);
+				scale.setMemoization(false);
+			}
+			else
+			if (variant >= 7)
+			{
+				// transformed while written, then restored by the test
+				static const char *TRANSFORMS[] = { "rotate90", "rotate180", "rotate270", "flipH",
+					"flipV" };
+				HQxTransform transform = (HQxTransform) (HQX_ROTATE_90 + variant - 7);
+				name = string("resizeParallel/") + TRANSFORMS[variant - 7];
+				std::fill(output.begin(), output.end(), 0);
+				scale.setTransform(transform);
+				scale.resizeParallel(golden.pool2, image.pixels.data(), width, height, output.data(),
+					preset.trY, preset.trU, preset.trV, preset.trA, wrapX, wrapY);
+				scale.setTransform(HQX_IDENTITY);
+				output = golden_untransform(output, width * factor, height * factor, transform);
+			}
+			else
+			if (variant >= 2)
+			{
+				ThreadPool &pool = *pools[variant - 2];
+				name = "resizeParallel/t" + std::to_string(pool.getSize());
+				std::fill(output.begin(), output.end(), 0);
+				scale.resizeParallel(pool, image.pixels.data(), width, height, output.data(),
+					preset.trY, preset.trU, preset.trV, preset.trA, wrapX, wrapY);
+			}
+
+			golden_compare(golden, key, name, golden_checksums(output, width, height, factor),
+				width, factor);
+		}
+	}
+}
+
+
+/**
+ * @brief Scaling and resampling to arbitrary sizes in the same pass.
+ */
+static void golden_testResizeTo(
+	Golden &golden )
+{
+	for (size_t i = 0; i < golden.images.size(); ++i)
+	for (size_t s = 0; s < golden.scalers.size(); ++s)
+	for (size_t k = 0; k < sizeof(RESAMPLE_SIZES) / sizeof(RESAMPLE_SIZES[0]); ++k)
+	{
+		const Image &image = golden.images[i];
+		HQx &scale = *golden.scalers[s];
+		uint32_t width = image.width * RESAMPLE_SIZES[k][0] / 4;
+		uint32_t height = image.height * RESAMPLE_SIZES[k][1] / 4;
+		string key = golden_key(image, golden.names[s], "resizeTo-" +
+			std::to_string(width) + "x" + std::to_string(height));
+
+		std::vector<uint32_t> output((size_t) width * height);
+		scale.resizeTo(image.pixels.data(), image.width, image.height, output.data(), width, height);
+		std::vector<uint32_t> reference = golden_checksums(output, width, height, 1);
+		if (golden_record(golden, key, reference)) continue;
+		golden_compare(golden, key, "resizeTo", reference, width, 1);
+
+		std::fill(output.begin(), output.end(), 0);
+		scale.resizeTo(image.pixels.data(), image.width, image.height, output.data(), width, height,
+			0x30, 0x07, 0x06, 0x50, false, false, &golden.pool4);
+		golden_compare(golden, key, "resizeTo/t4", golden_checksums(output, width, height, 1),
+			width, 1);
+
+		std::vector<uint32_t> rotated(output.size());
+		scale.setTransform(HQX_ROTATE_270);
+		scale.resizeTo(image.pixels.data(), image.width, image.height, rotated.data(), width, height);
+		scale.setTransform(HQX_IDENTITY);
+		rotated = golden_untransform(rotated, width, height, HQX_ROTATE_270);
+		golden_compare(golden, key, "resizeTo/rotate270", golden_checksums(rotated, width, height,
+			1), width, 1);
+	}
+}
+
+
+/**
+ * @brief AYUV input and output, packed and planar (4:4:4 and 4:2:0).
+ */
+static void golden_testYUV(
+	Golden &golden )
+{
+	for (size_t i = 0; i < golden.images.size(); ++i)
+	for (size_t s = 0; s < golden.scalers.size(); ++s)
+	{
+		const Image &image = golden.images[i];
+		HQx &scale = *golden.scalers[s];
+		uint32_t factor = scale.getFactor();
+		uint32_t width = image.width * factor;
+		uint32_t height = image.height * factor;
+		string key = golden_key(image, golden.names[s], "ayuv");
+
+		std::vector<uint32_t> input(image.pixels.size());
+		for (size_t j = 0; j < input.size(); ++j)
+			input[j] = HQx::ARGBtoAYUV(image.pixels[j]);
+
+		std::vector<uint32_t> output((size_t) width * height), parallel(output.size());
+		scale.setColorSpace(HQX_AYUV);
+		scale.resize(input.data(), image.width, image.height, output.data(), 0x30, 0x07, 0x06, 0x50);
+		if (!golden.record)
+			scale.resizeParallel(golden.pool4, input.data(), image.width, image.height,
+				parallel.data());
+		scale.setColorSpace(HQX_ARGB);
+		std::vector<uint32_t> reference = golden_checksums(output, width, height, 1);
+		if (golden_record(golden, key, reference)) continue;
+		golden_compare(golden, key, "resize", reference, width, 1);
+		golden_expect(golden, key, "resizeParallel/t4", parallel == output);
+
+		// planar input, and planar output with and without chroma subsampling
+		std::vector<uint8_t> source(input.size() * 4);
+		HQxYUVImage planar = { { NULL, NULL, NULL, NULL }, { image.width, image.width,
+			image.width, image.width }, false };
+		for (int p = 0; p < 4; ++p)
+		{
+			planar.planes[p] = source.data() + p * input.size();
+			for (size_t j = 0; j < input.size(); ++j)
+				planar.planes[p][j] = (uint8_t) (input[j] >> ((p == 3) ? 24 : 16 - 8 * p));
+		}
+
+		uint32_t chromaWidth = (width + 1) / 2;
+		uint32_t chromaHeight = (height + 1) / 2;
+		std::vector<uint8_t> full(output.size() * 4), subsampled(output.size() * 2 +
+			(size_t) chromaWidth * chromaHeight * 2);
+		HQxYUVImage planes444 = { { NULL, NULL, NULL, NULL }, { width, width, width, width }, false };
+		HQxYUVImage planes420 = { { NULL, NULL, NULL, NULL }, { width, chromaWidth, chromaWidth, width },
+			true };
+		for (int p = 0; p < 4; ++p)
+			planes444.planes[p] = full.data() + p * output.size();
+		planes420.planes[0] = subsampled.data();
+		planes420.planes[3] = subsampled.data() + output.size();
+		planes420.planes[1] = subsampled.data() + output.size() * 2;
+		planes420.planes[2] = planes420.planes[1] + (size_t) chromaWidth * chromaHeight;
+		scale.resizeYUV(planar, image.width, image.height, planes444);
+		scale.resizeYUV(planar, image.width, image.height, planes420, 0x30, 0x07, 0x06, 0x50, false,
+			false, &golden.pool4);
+
+		std::vector<uint32_t> repacked(output.size());
+		bool chroma = true;
+		for (uint32_t y = 0; y < height; ++y)
+			for (uint32_t x = 0; x < width; ++x)
+			{
+				size_t j = (size_t) y * width + x;
+				repacked[j] = ((uint32_t) planes444.planes[3][j] << 24) |
+					((uint32_t) planes444.planes[0][j] << 16) | ((uint32_t) planes444.planes[1][j] << 8) |
+					planes444.planes[2][j];
+				if (planes420.planes[0][j] != planes444.planes[0][j] ||
+					planes420.planes[3][j] != planes444.planes[3][j]) chroma = false;
+				if ((x & 1) || (y & 1)) continue;
+
+				// average of the 2x2 block, repeating the last row or column
+				size_t right = (x + 1 < width) ? j + 1 : j;
+				size_t below = (y + 1 < height) ? width : 0;
+				for (int p = 1; p < 3; ++p)
+				{
+					const uint8_t *plane = planes444.planes[p];
+					uint32_t sum = plane[j] + plane[right] + plane[j + below] + plane[right + below];
+					if (planes420.planes[p][(y / 2) * chromaWidth + x / 2] != (sum + 2) / 4)
+						chroma = false;
+				}
+			}
+
+		golden_expect(golden, key, "resizeYUV/444", repacked == output);
+		golden_expect(golden, key, "resizeYUV/420", chroma);
+	}
+}
+
+
+/**
+ * @brief Single-channel images (the luma of the images).
+ */
+static void golden_testGray(
+	Golden &golden )
+{
+	for (size_t i = 0; i < golden.images.size(); ++i)
+	for (size_t s = 0; s < golden.scalers.size(); ++s)
+	{
+		const Image &image = golden.images[i];
+		const HQx &scale = *golden.scalers[s];
+		uint32_t factor = scale.getFactor();
+		uint32_t width = image.width * factor;
+		uint32_t height = image.height * factor;
+		string key = golden_key(image, golden.names[s], "gray");
+
+		std::vector<uint8_t> input(image.pixels.size());
+		for (size_t j = 0; j < input.size(); ++j)
+			input[j] = (uint8_t) (HQx::ARGBtoAYUV(image.pixels[j]) >> 16);
+
+		std::vector<uint8_t> output((size_t) width * height), parallel(output.size());
+		scale.resizeGray(input.data(), image.width, image.height, output.data());
+		std::vector<uint32_t> reference = golden_checksums(std::vector<uint32_t>(output.begin(),
+			output.end()), width, height, 1);
+		if (golden_record(golden, key, reference)) continue;
+		golden_compare(golden, key, "resizeGray", reference, width, 1);
+
+		scale.resizeGray(input.data(), image.width, image.height, parallel.data(), 0x30, false,
+			false, &golden.pool4);
+		golden_expect(golden, key, "resizeGray/t4", parallel == output);
+	}
+}
+
+
+/**
+ * @brief Transparent blocks skipped with straight and premultiplied alpha.
+ */
+static void golden_testAlpha(
+	Golden &golden )
+{
+	for (size_t i = 0; i < golden.images.size(); ++i)
+	for (size_t s = 0; s < golden.scalers.size(); ++s)
+	{
+		const Image &image = golden.images[i];
+		HQx &scale = *golden.scalers[s];
+		uint32_t factor = scale.getFactor();
+		uint32_t width = image.width * factor;
+		uint32_t height = image.height * factor;
+		string key = golden_key(image, golden.names[s], "premultiplied");
+
+		std::vector<uint32_t> input(image.pixels);
+		HQx::premultiply(input.data(), input.size());
+
+		std::vector<uint32_t> output((size_t) width * height);
+		scale.resize(input.data(), image.width, image.height, output.data(), 0x30, 0x07, 0x06, 0x50);
+		std::vector<uint32_t> reference = golden_checksums(output, width, height, 1);
+		if (golden_record(golden, key, reference)) continue;
+		golden_compare(golden, key, "resize", reference, width, 1);
+
+		// skipping the zero blocks must not change the premultiplied output
+		std::vector<uint32_t> premultiplied(output.size()), rotated(output.size());
+		scale.setAlphaMode(HQX_ALPHA_PREMULTIPLIED);
+		scale.resize(input.data(), image.width, image.height, premultiplied.data(), 0x30, 0x07,
+			0x06, 0x50);
+		scale.setTransform(HQX_ROTATE_90);
+		scale.resizeParallel(golden.pool4, input.data(), image.width, image.height, rotated.data());
+		scale.setTransform(HQX_IDENTITY);
+		rotated = golden_untransform(rotated, width, height, HQX_ROTATE_90);
+		golden_expect(golden, key, "premultiplied", premultiplied == output);
+		golden_expect(golden, key, "premultiplied/rotate90/t4", rotated == output);
+
+		// with straight alpha only the blocks which are already transparent may change
+		std::vector<uint32_t> straight(output.size()), skipped(output.size());
+		scale.resize(image.pixels.data(), image.width, image.height, straight.data(), 0x30, 0x07,
+			0x06, 0x50);
+		scale.setAlphaMode(HQX_ALPHA_SKIP);
+		scale.resize(image.pixels.data(), image.width, image.height, skipped.data(), 0x30, 0x07,
+			0x06, 0x50);
+		scale.setAlphaMode(HQX_ALPHA_STRAIGHT);
+		bool transparent = true;
+		for (size_t j = 0; j < straight.size(); ++j)
+		{
+			if (skipped[j] != straight[j] && (skipped[j] != 0 || (straight[j] >> 24) != 0))
+				transparent = false;
+		}
+		golden_expect(golden, key, "skip", transparent);
+	}
+}
+
+
+/**
+ * @brief Sprites of an atlas, each resized with its own borders.
+ */
+static void golden_testAtlas(
+	Golden &golden )
+{
+	if (golden.record) return;
+
+	for (size_t i = 0; i < golden.images.size(); ++i)
+	for (size_t s = 0; s < golden.scalers.size(); ++s)
+	{
+		const Image &image = golden.images[i];
+		HQx &scale = *golden.scalers[s];
+		uint32_t factor = scale.getFactor();
+		uint32_t width = image.width * factor;
+		uint32_t height = image.height * factor;
+		string key = golden_key(image, golden.names[s], "atlas");
+
+		// a grid of 16x16 sprites, with smaller ones at the right and bottom borders
+		std::vector<HQxRect> rects;
+		for (uint32_t y = 0; y < image.height; y += 16)
+			for (uint32_t x = 0; x < image.width; x += 16)
+			{
+				HQxRect rect = { x, y, std::min(16U, image.width - x), std::min(16U,
+					image.height - y) };
+				rects.push_back(rect);
+			}
+
+		std::vector<uint32_t> atlas((size_t) width * height), rotated(atlas.size());
+		scale.resizeAtlas(image.pixels.data(), image.width, image.height, atlas.data(),
+			rects.data(), (uint32_t) rects.size(), 0x30, 0x07, 0x06, 0x50, false, false,
+			&golden.pool4);
+		scale.setTransform(HQX_ROTATE_180);
+		scale.resizeAtlas(image.pixels.data(), image.width, image.height, rotated.data(),
+			rects.data(), (uint32_t) rects.size(), 0x30, 0x07, 0x06, 0x50, true, true);
+		scale.setTransform(HQX_IDENTITY);
+
+		bool same = true, sameRotated = true;
+		for (size_t r = 0; r < rects.size(); ++r)
+		{
+			const HQxRect &rect = rects[r];
+			std::vector<uint32_t> sprite((size_t) rect.width * rect.height);
+			for (uint32_t y = 0; y < rect.height; ++y)
+				memcpy(sprite.data() + y * rect.width, image.pixels.data() + (rect.y + y) *
+					image.width + rect.x, rect.width * sizeof(uint32_t));
+
+			uint32_t spriteWidth = rect.width * factor;
+			uint32_t spriteHeight = rect.height * factor;
+			std::vector<uint32_t> output((size_t) spriteWidth * spriteHeight), flipped(output.size());
+			scale.resize(sprite.data(), rect.width, rect.height, output.data(), 0x30, 0x07, 0x06,
+				0x50);
+			scale.setTransform(HQX_ROTATE_180);
+			scale.resize(sprite.data(), rect.width, rect.height, flipped.data(), 0x30, 0x07, 0x06,
+				0x50, true, true);
+			scale.setTransform(HQX_IDENTITY);
+
+			for (uint32_t y = 0; y < spriteHeight; ++y)
+			{
+				size_t offset = (size_t) (rect.y * factor + y) * width + rect.x * factor;
+				if (memcmp(atlas.data() + offset, output.data() + y * spriteWidth,
+					spriteWidth * sizeof(uint32_t)) != 0)
+					same = false;
+				if (memcmp(rotated.data() + offset, flipped.data() + y * spriteWidth,
+					spriteWidth * sizeof(uint32_t)) != 0)
+					sameRotated = false;
+			}
+		}
+
+		golden_expect(golden, key, "resizeAtlas/t4", same);
+		golden_expect(golden, key, "resizeAtlas/rotate180/wrap", sameRotated);
+	}
+}
+
+
+/**
+ * @brief Tiles drawn from a cache, which must be the same as resizing the
+ * whole image.
+ */
+static void golden_testTileCache(
+	Golden &golden )
+{
+	if (golden.record) return;
+
+	for (size_t i = 0; i < golden.images.size(); ++i)
+	for (size_t s = 0; s < golden.scalers.size(); ++s)
+	{
+		const Image &image = golden.images[i];
+		HQx &scale = *golden.scalers[s];
+		uint32_t factor = scale.getFactor();
+		uint32_t width = image.width * factor;
+		uint32_t height = image.height * factor;
+		string key = golden_key(image, golden.names[s], "tiles");
+
+		std::vector<uint32_t> reference((size_t) width * height), wrapped(reference.size());
+		scale.resize(image.pixels.data(), image.width, image.height, reference.data(), 0x30, 0x07,
+			0x06, 0x50);
+		scale.resize(image.pixels.data(), image.width, image.height, wrapped.data(), 0x30, 0x07,
+			0x06, 0x50, true, true);
+
+		// the second pass is made only of hits; the small cache evicts most tiles
+		HQxTileCache cache(scale, 1 << 24), small(scale, 16 * 1024);
+		std::vector<uint32_t> output(reference.size()), cached(reference.size()),
+			evicted(reference.size());
+		cache.drawTiles(image.pixels.data(), image.width, image.height, 8, 8, output.data());
+		uint64_t tiles = cache.getStats().hits + cache.getStats().misses;
+		cache.resetStats();
+		cache.drawTiles(image.pixels.data(), image.width, image.height, 8, 8, cached.data());
+		small.drawTiles(image.pixels.data(), image.width, image.height, 8, 8, evicted.data(),
+			true, true);
+
+		golden_expect(golden, key, "HQxTileCache", output == reference && cached == reference &&
+			cache.getStats().hits == tiles);
+		golden_expect(golden, key, "HQxTileCache/small", small.getStats().memory <= 16 * 1024 ||
+			small.getStats().entries <= 1, "memory limit exceeded");
+		golden_expect(golden, key, "HQxTileCache/small/wrap", evicted == wrapped);
+
+		// the tiles resized before the settings of the scaler change are not used
+		std::vector<uint32_t> fast(reference.size()), fastCached(reference.size());
+		scale.setQuality(HQX_QUALITY_FAST);
+		scale.resize(image.pixels.data(), image.width, image.height, fast.data(), 0x30, 0x07,
+			0x06, 0x50);
+		cache.drawTiles(image.pixels.data(), image.width, image.height, 8, 8, fastCached.data());
+		scale.setQuality(HQX_QUALITY_FULL);
+		golden_expect(golden, key, "HQxTileCache/settings", fastCached == fast);
+	}
+}
+
+
+/**
+ * @brief Tiles rendered on demand from the map of the comparisons.
+ */
+static void golden_testMap(
+	Golden &golden )
+{
+	if (golden.record) return;
+
+	for (size_t i = 0; i < golden.images.size(); ++i)
+	{
+		const Image &image = golden.images[i];
+		HQxMap map, wrapped;
+		map.build(image.pixels.data(), image.width, image.height, 0x30, 0x07, 0x06, 0x50, false,
+			false, &golden.pool4);
+		wrapped.build(image.pixels.data(), image.width, image.height, 0x30, 0x07, 0x06, 0x50, true,
+			true);
+
+		for (size_t s = 0; s < golden.scalers.size(); ++s)
+		{
+			const HQx &scale = *golden.scalers[s];
+			uint32_t factor = scale.getFactor();
+			uint32_t width = image.width * factor;
+			uint32_t height = image.height * factor;
+			string key = golden_key(image, golden.names[s], "map");
+
+			std::vector<uint32_t> reference((size_t) width * height), output(reference.size());
+			std::vector<uint32_t> referenceWrapped(reference.size()), outputWrapped(reference.size());
+			scale.resize(image.pixels.data(), image.width, image.height, reference.data(), 0x30,
+				0x07, 0x06, 0x50);
+			scale.resize(image.pixels.data(), image.width, image.height, referenceWrapped.data(),
+				0x30, 0x07, 0x06, 0x50, true, true);
+
+			// tiles of 24x16 source pixels, rendered in reverse order
+			for (uint32_t y = (image.height - 1) / 16 * 16 + 16; y > 0; y -= 16)
+				for (uint32_t x = (image.width - 1) / 24 * 24 + 24; x > 0; x -= 24)
+				{
+					HQxRect rect = { x - 24, y - 16, std::min(24U, image.width - x + 24),
+						std::min(16U, image.height - y + 16) };
+					size_t offset = (size_t) rect.y * factor * width + rect.x * factor;
+					map.render(scale, rect, output.data() + offset, width);
+					wrapped.render(scale, rect, outputWrapped.data() + offset, width);
+				}
+
+			golden_expect(golden, key, "HQxMap", output == reference);
+			golden_expect(golden, key, "HQxMap/wrap", outputWrapped == referenceWrapped);
+		}
+	}
+}
+
+
+/**
+ * @brief Progressive resizing, refined from the viewport and cancelled.
+ */
+static void golden_testProgressive(
+	Golden &golden )
+{
+	if (golden.record) return;
+
+	for (size_t i = 0; i < golden.images.size(); ++i)
+	for (size_t s = 0; s < golden.scalers.size(); ++s)
+	{
+		const Image &image = golden.images[i];
+		const HQx &scale = *golden.scalers[s];
+		uint32_t factor = scale.getFactor();
+		uint32_t width = image.width * factor;
+		uint32_t height = image.height * factor;
+		string key = golden_key(image, golden.names[s], "progressive");
+
+		std::vector<uint32_t> reference((size_t) width * height), output(reference.size());
+		scale.resize(image.pixels.data(), image.width, image.height, reference.data(), 0x30, 0x07,
+			0x06, 0x50);
+
+		std::mutex lock;
+		std::vector<HQxRect> tiles;
+		HQxProgressive::Callback callback = [&](const HQxRect &tile)
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			tiles.push_back(tile);
+		};
+		HQxRect viewport = { image.width / 2, image.height / 2, 8, 8 };
+		HQxProgressive progressive(scale, 16);
+		progressive.start(image.pixels.data(), image.width, image.height, output.data(), viewport,
+			callback);
+		progressive.wait();
+		bool first = !tiles.empty() && tiles[0].x < viewport.x + viewport.width &&
+			tiles[0].y < viewport.y + viewport.height && tiles[0].x + tiles[0].width > viewport.x &&
+			tiles[0].y + tiles[0].height > viewport.y;
+		golden_expect(golden, key, "HQxProgressive", first && progressive.getTileCount() > 0,
+			"the viewport was not refined first");
+
+		// the tiles not refined keep the nearest-neighbor preview
+		tiles.clear();
+		progressive.start(image.pixels.data(), image.width, image.height, output.data(), viewport,
+			callback);
+		progressive.cancel();
+		std::vector<uint32_t> expected = golden_nearest(image, factor);
+		for (size_t t = 0; t < tiles.size(); ++t)
+			for (uint32_t y = tiles[t].y * factor; y < (tiles[t].y + tiles[t].height) * factor; ++y)
+				memcpy(expected.data() + (size_t) y * width + tiles[t].x * factor, reference.data() +
+					(size_t) y * width + tiles[t].x * factor, tiles[t].width * factor *
+					sizeof(uint32_t));
+		golden_expect(golden, key, "HQxProgressive/cancel", output == expected &&
+			progressive.getRefinedTiles() == tiles.size());
+	}
+}
+
+
+/**
+ * @brief Fast quality, in one call and in bands.
+ */
+static void golden_testFastQuality(
+	Golden &golden )
+{
+	for (size_t i = 0; i < golden.images.size(); ++i)
+	for (size_t s = 0; s < golden.scalers.size(); ++s)
+	{
+		const Image &image = golden.images[i];
+		HQx &scale = *golden.scalers[s];
+		uint32_t factor = scale.getFactor();
+		uint32_t width = image.width * factor;
+		uint32_t height = image.height * factor;
+		string key = golden_key(image, golden.names[s], "fast");
+
+		std::vector<uint32_t> output((size_t) width * height), parallel(output.size());
+		scale.setQuality(HQX_QUALITY_FAST);
+		scale.resize(image.pixels.data(), image.width, image.height, output.data(), 0x30, 0x07,
+			0x06, 0x50);
+		if (!golden.record)
+			scale.resizeParallel(golden.pool4, image.pixels.data(), image.width, image.height,
+				parallel.data(), 0x30, 0x07, 0x06, 0x50);
+		scale.setQuality(HQX_QUALITY_FULL);
+		std::vector<uint32_t> reference = golden_checksums(output, width, height, 1);
+		if (golden_record(golden, key, reference)) continue;
+		golden_compare(golden, key, "fast", reference, width, 1);
+		golden_expect(golden, key, "fast/t4", parallel == output);
+	}
+}
+
+
+/**
+ * @brief Frames resized within a budget.
+ */
+static void golden_testGovernor(
+	Golden &golden )
+{
+	if (golden.record) return;
+
+	for (size_t i = 0; i < golden.images.size(); ++i)
+	for (size_t s = 0; s < golden.scalers.size(); ++s)
+	{
+		const Image &image = golden.images[i];
+		HQx &scale = *golden.scalers[s];
+		uint32_t factor = scale.getFactor();
+		uint32_t width = image.width * factor;
+		uint32_t height = image.height * factor;
+		string key = golden_key(image, golden.names[s], "governor");
+
+		// without a deadline the governor must produce the full quality output
+		std::vector<uint32_t> full((size_t) width * height), governed(full.size());
+		scale.resize(image.pixels.data(), image.width, image.height, full.data(), 0x30, 0x07,
+			0x06, 0x50);
+		HQxGovernor relaxed(scale, 1e9, &golden.pool4);
+		relaxed.resize(image.pixels.data(), image.width, image.height, governed.data());
+		relaxed.resize(image.pixels.data(), image.width, image.height, governed.data());
+		golden_expect(golden, key, "HQxGovernor", governed == full &&
+			relaxed.getDegradedFrames() == 0 && scale.getQuality() == HQX_QUALITY_FULL);
+
+		// without any time every band must be replaced by nearest-neighbor
+		HQxGovernor strict(scale, 0);
+		const HQxFrameReport &report = strict.resize(image.pixels.data(), image.width,
+			image.height, governed.data());
+		golden_expect(golden, key, "HQxGovernor/nearest", report.degraded &&
+			report.nearestBands == report.bands && governed == golden_nearest(image, factor));
+	}
+}
+
+
+/**
+ * @brief Scale2x and Scale3x, with SIMD rows and with the generic rows.
+ */
+static void golden_testScaleEngines(
+	Golden &golden )
+{
+	Scale2x scale2x;
+	Scale3x scale3x;
+	HQx *engines[] = { &scale2x, &scale3x };
+	const char *names[] = { "scale2x", "scale3x" };
+
+	for (size_t i = 0; i < golden.images.size(); ++i)
+	for (size_t s = 0; s < sizeof(engines) / sizeof(HQx*); ++s)
+	for (int wrap = 0; wrap < 4; ++wrap)
+	{
+		const Image &image = golden.images[i];
+		HQx &scale = *engines[s];
+		bool wrapX = (wrap & 1) != 0;
+		bool wrapY = (wrap & 2) != 0;
+		uint32_t factor = scale.getFactor();
+		uint32_t width = image.width * factor;
+		uint32_t height = image.height * factor;
+		string key = golden_key(image, names[s], golden_wrapName(wrap));
+
+		std::vector<uint32_t> output((size_t) width * height);
+		scale.resize(image.pixels.data(), image.width, image.height, output.data(), 0x30, 0x07,
+			0x06, 0x50, wrapX, wrapY);
+		std::vector<uint32_t> reference = golden_checksums(output, image.width, image.height,
+			factor);
+		if (golden_record(golden, key, reference)) continue;
+		golden_compare(golden, key, "resize", reference, image.width, factor);
+
+		std::vector<uint32_t> parallel(output.size()), rotated(output.size());
+		scale.resizeParallel(golden.pool4, image.pixels.data(), image.width, image.height,
+			parallel.data(), 0x30, 0x07, 0x06, 0x50, wrapX, wrapY);
+		scale.setTransform(HQX_ROTATE_90);
+		scale.resize(image.pixels.data(), image.width, image.height, rotated.data(), 0x30, 0x07,
+			0x06, 0x50, wrapX, wrapY);
+		scale.setTransform(HQX_IDENTITY);
+		rotated = golden_untransform(rotated, width, height, HQX_ROTATE_90);
+		golden_expect(golden, key, "resizeParallel/t4", parallel == output);
+		golden_expect(golden, key, "rotate90", rotated == output);
+	}
+}
+
+
+/**
+ * @brief Resized in place, with the image at the end of the output buffer.
+ */
+static void golden_testInPlace(
+	Golden &golden )
+{
+	if (golden.record) return;
+
+	for (size_t i = 0; i < golden.images.size(); ++i)
+	for (size_t s = 0; s < golden.scalers.size(); ++s)
+	for (int wrap = 0; wrap < 4; wrap += 3)
+	{
+		const Image &image = golden.images[i];
+		const HQx &scale = *golden.scalers[s];
+		bool wrapX = (wrap & 1) != 0;
+		bool wrapY = (wrap & 2) != 0;
+		uint32_t factor = scale.getFactor();
+		size_t size = image.pixels.size() * factor * factor;
+		string key = golden_key(image, golden.names[s], golden_wrapName(wrap));
+
+		std::vector<uint32_t> reference(size), buffer(size);
+		scale.resize(image.pixels.data(), image.width, image.height, reference.data(), 0x30, 0x07,
+			0x06, 0x50, wrapX, wrapY);
+		std::copy(image.pixels.begin(), image.pixels.end(), buffer.end() - image.pixels.size());
+		scale.resizeInPlace(buffer.data(), image.width, image.height, 0x30, 0x07, 0x06, 0x50,
+			wrapX, wrapY);
+		golden_expect(golden, key, "resizeInPlace", buffer == reference);
+	}
+}
+
+
+/**
+ * @brief Compared pixel by pixel with the outputs of the reference implementations.
+ */
+static void golden_testReference(
+	Golden &golden )
+{
+	if (golden.record) return;
+
+	for (size_t r = 0; r < sizeof(REFERENCES) / sizeof(Reference); ++r)
+	{
+		const Reference &reference = REFERENCES[r];
+		std::vector<uint32_t> source, expected;
+		uint32_t width, height, outputWidth, outputHeight;
+		if (Bitmap::load(golden.samplesDir + "/" + reference.output, expected, outputWidth,
+			outputHeight) != 0)
+		{
+			std::cout << golden.feature << ": '" << reference.output << "' not found, skipped" <<
+				std::endl;
+			continue;
+		}
+
+		const HQx &scale = *golden.scalers[reference.scaler];
+		uint32_t factor = scale.getFactor();
+		string key = string(reference.output) + "/" + golden.names[reference.scaler];
+		if (Bitmap::load(golden.samplesDir + "/" + reference.source, source, width, height) != 0 ||
+			outputWidth != width * factor || outputHeight != height * factor)
+		{
+			golden_expect(golden, key, "resize", false, "invalid reference");
+			continue;
+		}
+
+		std::vector<uint32_t> output(expected.size());
+		scale.resize(source.data(), width, height, output.data());
+		size_t differences = 0;
+		for (size_t i = 0; i < output.size(); ++i)
+			if (output[i] != expected[i]) ++differences;
+
+		char reason[64];
+		snprintf(reason, sizeof(reason), "%zu of %zu pixels differ", differences, output.size());
+		golden_expect(golden, key, "resize", differences == 0, reason);
+	}
+}
+
+
+struct GoldenTest
+{
+	const char *feature;
+	void (*run)( Golden &golden );
+};
+
+
+// in the order of the keys in the golden file
+static const GoldenTest GOLDEN_TESTS[] =
+{
+	{ "scalers", golden_testScalers },
+	{ "resizeTo", golden_testResizeTo },
+	{ "yuv", golden_testYUV },
+	{ "gray", golden_testGray },
+	{ "alpha", golden_testAlpha },
+	{ "atlas", golden_testAtlas },
+	{ "tileCache", golden_testTileCache },
+	{ "map", golden_testMap },
+	{ "progressive", golden_testProgressive },
+	{ "fastQuality", golden_testFastQuality },
+	{ "governor", golden_testGovernor },
+	{ "scaleEngines", golden_testScaleEngines },
+	{ "inPlace", golden_testInPlace },
+	{ "reference", golden_testReference },
+};
+
+
+static bool golden_loadImages(
+	const string &samplesDir,
+	std::vector<Image> &images )
+{
+	static const char *SAMPLES[] = { "prince.bmp", "prince-hq2x.bmp", "test-image.bmp",
+		"test-image-hq2x.bmp", "test-image-hq3x.bmp" };
+
+	for (size_t i = 0; i < sizeof(SAMPLES) / sizeof(SAMPLES[0]); ++i)
+	{
+		Image image;
+		image.name = SAMPLES[i];
+		if (Bitmap::load(samplesDir + "/" + SAMPLES[i], image.pixels, image.width, image.height) != 0)
+		{
+			std::cerr << "Unable to load '" << samplesDir << "/" << SAMPLES[i] << "'" << std::endl;
+			return false;
+		}
+		images.push_back(image);
+	}
+
+	const std::vector<CorpusSpec> &classes = Corpus::getClasses();
+	for (size_t i = 0; i < classes.size(); ++i)
+	{
+		Image image;
+		image.name = string("corpus-") + classes[i].name;
+		image.width = CORPUS_WIDTH;
+		image.height = CORPUS_HEIGHT;
+		Corpus::generate(classes[i], image.width, image.height, image.pixels);
+		images.push_back(image);
+	}
+
+	return true;
+}
+
+
+static bool golden_load(
+	const string &fileName,
+	std::map< string, std::vector<uint32_t> > &golden )
+{
+	std::ifstream input(fileName.c_str());
+	if (!input.good()) return false;
+
+	string line;
+	while (std::getline(input, line))
+	{
+		if (line.empty() || line[0] == '#') continue;
+
+		std::istringstream fields(line);
+		string key, value;
+		fields >> key;
+		std::vector<uint32_t> &checksums = golden[key];
+		while (fields >> value) checksums.push_back((uint32_t) strtoul(value.c_str(), NULL, 16));
+	}
+
+	return true;
+}
+
+
+int main( int argc, char **argv )
+{
+	if (argc != 3 && !(argc == 4 && strcmp(argv[3], "--record") == 0))
+	{
+		std::cerr << "Usage: hqx_golden <samples directory> <golden file> [--record]" << std::endl;
+		return 1;
+	}
+
+	Golden golden;
+	golden.record = (argc == 4);
+	golden.samplesDir = argv[1];
+	if (!golden_loadImages(argv[1], golden.images)) return 1;
+
+	if (golden.record)
+	{
+		golden.recorded.open(argv[2]);
+		golden.recorded << "# image/algorithm/wrap/preset followed by the checksum of each " <<
+			TILE_SIZE << "x" << TILE_SIZE << " source block (row by row)\n";
+	}
+	else
+	if (!golden_load(argv[2], golden.checksums))
+	{
+		std::cerr << "Unable to load the golden file '" << argv[2] << "'" << std::endl;
+		return 1;
+	}
+
+	for (size_t t = 0; t < sizeof(GOLDEN_TESTS) / sizeof(GoldenTest); ++t)
+	{
+		golden.feature = GOLDEN_TESTS[t].feature;
+		uint32_t cases = golden.cases, failures = golden.failures;
+		GOLDEN_TESTS[t].run(golden);
+		if (!golden.record)
+			std::cout << golden.feature << ": " << (golden.cases - cases) - (golden.failures -
+				failures) << " of " << golden.cases - cases << " cases passed" << std::endl;
+	}
+
+	if (golden.record)
+	{
+		std::cout << "Recorded the golden checksums in '" << argv[2] << "'" << std::endl;
+		return 0;
+	}
+
+	std::cout << golden.cases - golden.failures << " of " << golden.cases << " cases passed" <<
+		std::endl;
+	return (golden.failures > 0) ? 1 : 0;
+}